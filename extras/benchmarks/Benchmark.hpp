@@ -0,0 +1,36 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <stdio.h>
+#include <time.h>
+
+// Calls fn() repeatedly and returns the duration of a call in microseconds.
+// To reduce the noise, we run several batches and keep the fastest.
+template <typename TFunction>
+double measure(TFunction fn) {
+  const clock_t batchDuration = CLOCKS_PER_SEC / 10;
+  double best = 0;
+  for (int batch = 0; batch < 10; batch++) {
+    unsigned long iterations = 0;
+    clock_t start = clock();
+    clock_t elapsed;
+    do {
+      fn();
+      iterations++;
+      elapsed = clock() - start;
+    } while (elapsed < batchDuration);
+    double duration = 1e6 * static_cast<double>(elapsed) / CLOCKS_PER_SEC /
+                      static_cast<double>(iterations);
+    if (batch == 0 || duration < best)
+      best = duration;
+  }
+  return best;
+}
+
+inline void printResult(const char* name, double microseconds, size_t bytes) {
+  printf("%-40s %10.1f us %10.1f MB/s\n", name, microseconds,
+         static_cast<double>(bytes) / microseconds);
+}
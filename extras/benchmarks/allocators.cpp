@@ -0,0 +1,111 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+// Compares the allocators of BasicJsonDocument while 1 to 32 threads create,
+// fill, and destroy documents. The per-thread allocators have one instance
+// per thread; the shared slab has one instance for all threads.
+//
+// The durations are wall-clock times for all the threads, so they measure
+// the throughput rather than the latency.
+
+#include <ArduinoJson.h>
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+const int documentsPerThread = 20000;
+const size_t documentCapacity = 2048;
+const size_t bufferPerThread = 64 * 1024;
+
+template <typename TDocument>
+static void fillDocument(TDocument& doc, int i) {
+  JsonObject sensor = doc.createNestedObject("sensor");
+  sensor["id"] = i;
+  sensor["name"] = "thermometer";
+  JsonArray readings = doc.createNestedArray("readings");
+  for (int j = 0; j < 8; j++) readings.add(20 + j);
+}
+
+struct UseDefaultAllocator {
+  void operator()() const {
+    for (int i = 0; i < documentsPerThread; i++) {
+      DynamicJsonDocument doc(documentCapacity);
+      fillDocument(doc, i);
+    }
+  }
+};
+
+struct UseSlabAllocator {
+  void operator()() const {
+    std::vector<char> buffer(bufferPerThread);
+    SlabAllocator slab(&buffer[0], buffer.size());
+    for (int i = 0; i < documentsPerThread; i++) {
+      BasicJsonDocument<AllocatorRef<SlabAllocator> > doc(documentCapacity,
+                                                          slab);
+      fillDocument(doc, i);
+    }
+  }
+};
+
+struct UseSharedSlabAllocator {
+  UseSharedSlabAllocator(SharedSlabAllocator& slab) : _slab(&slab) {}
+
+  void operator()() const {
+    for (int i = 0; i < documentsPerThread; i++) {
+      BasicJsonDocument<AllocatorRef<SharedSlabAllocator> > doc(
+          documentCapacity, *_slab);
+      fillDocument(doc, i);
+    }
+  }
+
+  SharedSlabAllocator* _slab;
+};
+
+struct UseMonotonicArena {
+  void operator()() const {
+    std::vector<char> buffer(bufferPerThread);
+    MonotonicArena arena(&buffer[0], buffer.size());
+    for (int i = 0; i < documentsPerThread; i++) {
+      {
+        BasicJsonDocument<AllocatorRef<MonotonicArena> > doc(
+            documentCapacity, arena);
+        fillDocument(doc, i);
+      }
+      arena.reset();
+    }
+  }
+};
+
+// Runs fn() in the specified number of threads, and returns the average
+// duration of a document in nanoseconds.
+template <typename TFunction>
+static double run(int threads, TFunction fn) {
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (int i = 0; i < threads; i++) workers.push_back(std::thread(fn));
+  for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / documentsPerThread / threads;
+}
+
+int main() {
+  std::vector<char> sharedBuffer(64 * bufferPerThread);
+
+  printf("%-8s %14s %14s %14s %14s\n", "threads", "default", "slab",
+         "shared slab", "arena");
+  for (int threads = 1; threads <= 32; threads *= 2) {
+    SharedSlabAllocator sharedSlab(&sharedBuffer[0], sharedBuffer.size());
+    printf("%-8d %11.1f ns %11.1f ns %11.1f ns %11.1f ns\n", threads,
+           run(threads, UseDefaultAllocator()),
+           run(threads, UseSlabAllocator()),
+           run(threads, UseSharedSlabAllocator(sharedSlab)),
+           run(threads, UseMonotonicArena()));
+  }
+  return 0;
+}
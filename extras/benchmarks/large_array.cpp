@@ -0,0 +1,46 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+// Compares the speed of the access by index in a large array (like a series
+// of samples), with and without ARDUINOJSON_ENABLE_DENSE_ARRAYS.
+
+#include <ArduinoJson.h>
+
+#include <sstream>
+#include <string>
+
+#include "Benchmark.hpp"
+#include "large_array.hpp"
+
+static std::string createLargeArray(int samples) {
+  std::ostringstream s;
+  s << '[';
+  for (int i = 0; i < samples; i++) {
+    if (i > 0)
+      s << ',';
+    s << 2000 + i * 37 % 500;
+  }
+  s << ']';
+  return s.str();
+}
+
+static void run(int samples) {
+  std::string input = createLargeArray(samples);
+  DynamicJsonDocument doc(largeArrayCapacity(input));
+  deserializeJson(doc, input);
+
+  char name[64];
+  sprintf(name, "%d samples, index all", samples);
+  printResult(name, measure(IndexLargeArray<DynamicJsonDocument>(doc)),
+              input.size());
+  sprintf(name, "%d samples, index all, dense", samples);
+  printResult(name, measureIndexDense(input), input.size());
+}
+
+int main() {
+  run(100);
+  run(1000);
+  run(10000);
+  return 0;
+}
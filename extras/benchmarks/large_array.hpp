@@ -0,0 +1,28 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <string>
+
+// Defined in large_array_dense.cpp, which enables
+// ARDUINOJSON_ENABLE_DENSE_ARRAYS
+double measureIndexDense(const std::string& input);
+
+template <typename TDocument>
+struct IndexLargeArray {
+  IndexLargeArray(TDocument& doc) : _doc(&doc), _sum(0) {}
+
+  void operator()() {
+    size_t n = _doc->size();
+    for (size_t i = 0; i < n; i++) _sum += (*_doc)[i].template as<long>();
+  }
+
+  TDocument* _doc;
+  long _sum;
+};
+
+inline size_t largeArrayCapacity(const std::string& input) {
+  return 8 * input.size();
+}
@@ -0,0 +1,15 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#define ARDUINOJSON_ENABLE_DENSE_ARRAYS 1
+#include <ArduinoJson.h>
+
+#include "Benchmark.hpp"
+#include "large_array.hpp"
+
+double measureIndexDense(const std::string& input) {
+  DynamicJsonDocument doc(largeArrayCapacity(input));
+  deserializeJson(doc, input);
+  return measure(IndexLargeArray<DynamicJsonDocument>(doc));
+}
@@ -0,0 +1,57 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+// Compares the speed of deserializeJson() on a large document (like a bulk
+// export), with and without ARDUINOJSON_ENABLE_STRUCTURAL_INDEX.
+
+#include <ArduinoJson.h>
+
+#include <sstream>
+#include <string>
+
+#include "Benchmark.hpp"
+#include "large_document.hpp"
+
+static std::string createLargeDocument(int records) {
+  std::ostringstream s;
+  s << '[';
+  for (int i = 0; i < records; i++) {
+    if (i > 0)
+      s << ',';
+    s << "{\"id\":" << i << ",\"guid\":\"5f1c" << i * 7919
+      << "-90ab-4cde-8f01-23456789abcd\",\"active\":"
+      << (i % 3 ? "true" : "false") << ",\"balance\":" << i * 1.37
+      << ",\"name\":\"Customer " << i << "\",\"email\":\"customer" << i
+      << "@example.com\",\"tags\":[\"bulk\",\"export\",\"t" << i % 17
+      << "\"],\"address\":{\"street\":\"" << i
+      << " Main Street\",\"city\":\"Springfield\",\"zip\":\"" << 10000 + i
+      << "\"},\"about\":\"Lorem ipsum dolor sit amet, consectetur adipiscing"
+         " elit, sed do eiusmod tempor incididunt ut labore et dolore magna "
+         "aliqua. Ut enim ad \\\"minim\\\" veniam, quis nostrud exercitation."
+         "\"}";
+  }
+  s << ']';
+  return s.str();
+}
+
+int main() {
+  std::string minified = createLargeDocument(20000);
+
+  DynamicJsonDocument doc(largeDocumentCapacity(minified));
+  deserializeJson(doc, minified);
+  std::string indented;
+  serializeJsonPretty(doc, indented);
+
+  printResult("minified", measure(ParseLargeDocument<DynamicJsonDocument>(
+                              doc, minified)),
+              minified.size());
+  printResult("minified, two stages", measureTwoStage(minified),
+              minified.size());
+  printResult("indented", measure(ParseLargeDocument<DynamicJsonDocument>(
+                              doc, indented)),
+              indented.size());
+  printResult("indented, two stages", measureTwoStage(indented),
+              indented.size());
+  return 0;
+}
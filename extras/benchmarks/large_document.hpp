@@ -0,0 +1,29 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <string>
+
+// Defined in large_document_two_stage.cpp, which enables
+// ARDUINOJSON_ENABLE_STRUCTURAL_INDEX
+double measureTwoStage(const std::string& input);
+
+template <typename TDocument>
+struct ParseLargeDocument {
+  ParseLargeDocument(TDocument& doc, const std::string& input)
+      : _doc(&doc), _input(&input) {}
+
+  void operator()() {
+    deserializeJson(*_doc, _input->data(), _input->size());
+  }
+
+  TDocument* _doc;
+  const std::string* _input;
+};
+
+// The document takes a bit more memory than the input
+inline size_t largeDocumentCapacity(const std::string& input) {
+  return 2 * input.size();
+}
@@ -0,0 +1,14 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#define ARDUINOJSON_ENABLE_STRUCTURAL_INDEX 1
+#include <ArduinoJson.h>
+
+#include "Benchmark.hpp"
+#include "large_document.hpp"
+
+double measureTwoStage(const std::string& input) {
+  DynamicJsonDocument doc(largeDocumentCapacity(input));
+  return measure(ParseLargeDocument<DynamicJsonDocument>(doc, input));
+}
@@ -0,0 +1,63 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+// Compares the speed of deserializeJson() and of the key lookups on objects
+// with many members, with and without ARDUINOJSON_ENABLE_OBJECT_INDEX, and
+// with DeserializationOption::UniqueKeys.
+
+#include <ArduinoJson.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "large_object.hpp"
+
+static std::string createLargeObject(int members,
+                                     std::vector<std::string>& keys) {
+  std::ostringstream s;
+  s << '{';
+  for (int i = 0; i < members; i++) {
+    std::ostringstream key;
+    key << "sensor_" << i * 7919 % 100003;
+    keys.push_back(key.str());
+    if (i > 0)
+      s << ',';
+    s << '"' << key.str() << "\":" << i;
+  }
+  s << '}';
+  return s.str();
+}
+
+static void run(int members) {
+  std::vector<std::string> keys;
+  std::string input = createLargeObject(members, keys);
+  DynamicJsonDocument doc(largeObjectCapacity(input));
+  deserializeJson(doc, input);
+
+  char name[64];
+  sprintf(name, "%d members, parse", members);
+  printResult(name, measure(ParseLargeObject<DynamicJsonDocument>(doc, input)),
+              input.size());
+  sprintf(name, "%d members, parse, unique keys", members);
+  printResult(name,
+              measure(ParseLargeObjectWithUniqueKeys<DynamicJsonDocument>(
+                  doc, input)),
+              input.size());
+  sprintf(name, "%d members, parse, with index", members);
+  printResult(name, measureParseWithIndex(input), input.size());
+  sprintf(name, "%d members, lookup all", members);
+  printResult(name, measure(LookupLargeObject<DynamicJsonDocument>(doc, keys)),
+              input.size());
+  sprintf(name, "%d members, lookup all, with index", members);
+  printResult(name, measureLookupWithIndex(input, keys), input.size());
+}
+
+int main() {
+  run(100);
+  run(1000);
+  run(10000);
+  return 0;
+}
@@ -0,0 +1,60 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Defined in large_object_index.cpp, which enables
+// ARDUINOJSON_ENABLE_OBJECT_INDEX
+double measureParseWithIndex(const std::string& input);
+double measureLookupWithIndex(const std::string& input,
+                              const std::vector<std::string>& keys);
+
+template <typename TDocument>
+struct ParseLargeObject {
+  ParseLargeObject(TDocument& doc, const std::string& input)
+      : _doc(&doc), _input(&input) {}
+
+  void operator()() {
+    deserializeJson(*_doc, _input->data(), _input->size());
+  }
+
+  TDocument* _doc;
+  const std::string* _input;
+};
+
+template <typename TDocument>
+struct ParseLargeObjectWithUniqueKeys {
+  ParseLargeObjectWithUniqueKeys(TDocument& doc, const std::string& input)
+      : _doc(&doc), _input(&input) {}
+
+  void operator()() {
+    deserializeJson(*_doc, _input->data(), _input->size(),
+                    DeserializationOption::UniqueKeys());
+  }
+
+  TDocument* _doc;
+  const std::string* _input;
+};
+
+template <typename TDocument>
+struct LookupLargeObject {
+  LookupLargeObject(TDocument& doc, const std::vector<std::string>& keys)
+      : _doc(&doc), _keys(&keys), _sum(0) {}
+
+  void operator()() {
+    for (size_t i = 0; i < _keys->size(); i++)
+      _sum += (*_doc)[(*_keys)[i]].template as<long>();
+  }
+
+  TDocument* _doc;
+  const std::vector<std::string>* _keys;
+  long _sum;
+};
+
+inline size_t largeObjectCapacity(const std::string& input) {
+  return 4 * input.size();
+}
@@ -0,0 +1,21 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#define ARDUINOJSON_ENABLE_OBJECT_INDEX 1
+#include <ArduinoJson.h>
+
+#include "Benchmark.hpp"
+#include "large_object.hpp"
+
+double measureParseWithIndex(const std::string& input) {
+  DynamicJsonDocument doc(largeObjectCapacity(input));
+  return measure(ParseLargeObject<DynamicJsonDocument>(doc, input));
+}
+
+double measureLookupWithIndex(const std::string& input,
+                              const std::vector<std::string>& keys) {
+  DynamicJsonDocument doc(largeObjectCapacity(input));
+  deserializeJson(doc, input);
+  return measure(LookupLargeObject<DynamicJsonDocument>(doc, keys));
+}
@@ -0,0 +1,88 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+// Compares the speed of deserializeJson() on minified and indented inputs.
+// The "char by char" lines use a custom reader, which disables the fast path
+// for inputs in RAM.
+
+#include <ArduinoJson.h>
+
+#include <string>
+
+#include "Benchmark.hpp"
+
+class CharByCharReader {
+ public:
+  CharByCharReader(const std::string& s) : _ptr(s.c_str()) {}
+
+  int read() {
+    return static_cast<unsigned char>(*_ptr++);
+  }
+
+  size_t readBytes(char* buffer, size_t length) {
+    for (size_t i = 0; i < length; i++) buffer[i] = *_ptr++;
+    return length;
+  }
+
+ private:
+  const char* _ptr;
+};
+
+struct ParseString {
+  ParseString(DynamicJsonDocument& doc, const std::string& input)
+      : _doc(&doc), _input(&input) {}
+
+  void operator()() {
+    deserializeJson(*_doc, _input->c_str(), _input->size());
+  }
+
+  DynamicJsonDocument* _doc;
+  const std::string* _input;
+};
+
+struct ParseCharByChar {
+  ParseCharByChar(DynamicJsonDocument& doc, const std::string& input)
+      : _doc(&doc), _input(&input) {}
+
+  void operator()() {
+    CharByCharReader reader(*_input);
+    deserializeJson(*_doc, reader);
+  }
+
+  DynamicJsonDocument* _doc;
+  const std::string* _input;
+};
+
+static void createDocument(JsonDocument& doc) {
+  JsonArray devices = doc.createNestedArray("devices");
+  for (int i = 0; i < 200; i++) {
+    JsonObject device = devices.createNestedObject();
+    device["id"] = i;
+    device["name"] = "thermometer";
+    JsonObject location = device.createNestedObject("location");
+    location["building"] = "B";
+    location["floor"] = i % 10;
+    JsonArray readings = device.createNestedArray("readings");
+    for (int j = 0; j < 4; j++) readings.add(20 + j);
+  }
+}
+
+int main() {
+  DynamicJsonDocument doc(256 * 1024);
+  createDocument(doc);
+
+  std::string minified, indented;
+  serializeJson(doc, minified);
+  serializeJsonPretty(doc, indented);
+
+  printResult("minified", measure(ParseString(doc, minified)),
+              minified.size());
+  printResult("minified, char by char", measure(ParseCharByChar(doc, minified)),
+              minified.size());
+  printResult("indented", measure(ParseString(doc, indented)),
+              indented.size());
+  printResult("indented, char by char", measure(ParseCharByChar(doc, indented)),
+              indented.size());
+  return 0;
+}
@@ -0,0 +1,113 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+
+static void checkCapacity(const std::string& input) {
+  DynamicJsonDocument doc(65536);
+  DeserializationError err = deserializeJson(doc, input);
+  REQUIRE(err == DeserializationError::Ok);
+
+  REQUIRE(measureJsonCapacity(input) == doc.memoryUsage());
+  REQUIRE(measureJsonCapacity(input.c_str()) == doc.memoryUsage());
+  REQUIRE(measureJsonCapacity(input.data(), input.size()) ==
+          doc.memoryUsage());
+}
+
+TEST_CASE("measureJsonCapacity()") {
+  SECTION("Values") {
+    checkCapacity("42");
+    checkCapacity("true");
+    checkCapacity("null");
+    checkCapacity("\"hello\"");
+  }
+
+  SECTION("Empty collections") {
+    checkCapacity("[]");
+    checkCapacity("{}");
+    checkCapacity(" [ ] ");
+  }
+
+  SECTION("Arrays") {
+    checkCapacity("[1,2,3]");
+    checkCapacity("[\"a\",\"bc\",[\"def\"],[]]");
+  }
+
+  SECTION("Objects") {
+    checkCapacity("{\"a\":1,\"bc\":\"def\"}");
+    checkCapacity("{\"a\":{\"b\":{\"c\":[1,{}]}}}");
+    checkCapacity("{ a : 'single quotes', b_c : 2 }");
+  }
+
+  SECTION("Escape sequences") {
+    checkCapacity("[\"1\\n2\\\"3\\\\4\\/5\\t\"]");
+  }
+
+  SECTION("Large document") {
+    std::ostringstream s;
+    s << '[';
+    for (int i = 0; i < 100; i++) {
+      if (i > 0)
+        s << ",\n  ";
+      s << "{\"id\":" << i << ",\"name\":\"item " << i
+        << "\",\"tags\":[\"a\",\"b\"]}";
+    }
+    s << ']';
+    checkCapacity(s.str());
+  }
+
+  SECTION("Strings take JSON_STRING_SIZE(), even when it rounds up") {
+    REQUIRE(measureJsonCapacity("\"ab\"") == JSON_STRING_SIZE(3));
+    REQUIRE(measureJsonCapacity("[\"ab\",\"cde\"]") ==
+            JSON_ARRAY_SIZE(2) + JSON_STRING_SIZE(3) + JSON_STRING_SIZE(4));
+  }
+
+  SECTION("Zero-copy") {
+    char input[] = "{\"hello\":\"world\"}";
+    REQUIRE(measureJsonCapacity(input) == JSON_OBJECT_SIZE(1));
+  }
+
+  SECTION("Doesn't modify the input") {
+    char input[] = "[\"a\\nb\"]";
+    measureJsonCapacity(input);
+    REQUIRE(std::string(input) == "[\"a\\nb\"]");
+  }
+
+  SECTION("Duplicate keys give an upper bound") {
+    DynamicJsonDocument doc(1024);
+    const char* input = "{\"a\":1,\"a\":2}";
+    deserializeJson(doc, input);
+
+    REQUIRE(measureJsonCapacity(input) >= doc.memoryUsage());
+  }
+
+  SECTION("Enough to deserialize") {
+    const char* input = "{\"sensor\":\"gps\",\"time\":1351824120,"
+                        "\"data\":[48.756080,2.302038]}";
+    DynamicJsonDocument doc(measureJsonCapacity(input));
+
+    DeserializationError err = deserializeJson(doc, input);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["data"][1] == 2.302038);
+  }
+
+  SECTION("Invalid input: enough to reach the error") {
+    const char* input = "[1,{\"a\":2";
+    DynamicJsonDocument doc(measureJsonCapacity(input));
+
+    DeserializationError err = deserializeJson(doc, input);
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("NestingLimit") {
+    DeserializationOption::NestingLimit nesting(1);
+
+    REQUIRE(measureJsonCapacity("[[1]]", nesting) == JSON_ARRAY_SIZE(1));
+  }
+}
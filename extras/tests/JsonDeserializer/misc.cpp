@@ -5,6 +5,8 @@
 #include <ArduinoJson.h>
 #include <catch.hpp>
 
+#include <sstream>
+
 using namespace Catch::Matchers;
 
 TEST_CASE("deserializeJson(DynamicJsonDocument&)") {
@@ -109,3 +111,57 @@ TEST_CASE("deserializeJson(DynamicJsonDocument&)") {
     REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(0));
   }
 }
+
+TEST_CASE("deserializeJson() with indented input") {
+  DynamicJsonDocument doc(4096);
+  std::string input =
+      "{\r\n"
+      "\t\t\"a\" :   [   1 ,\n"
+      "                           2   ],\n"
+      "                \t\t\t  \"b\" : {\r\n"
+      "                                          \"c\"  :  \"d\"\n"
+      "                }                           \n"
+      "}";
+  const char* output = "{\"a\":[1,2],\"b\":{\"c\":\"d\"}}";
+
+  SECTION("const char*") {
+    REQUIRE(deserializeJson(doc, input.c_str()) == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == output);
+  }
+
+  SECTION("const char*, size_t") {
+    REQUIRE(deserializeJson(doc, input.c_str(), input.size()) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == output);
+  }
+
+  SECTION("std::string") {
+    REQUIRE(deserializeJson(doc, input) == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == output);
+  }
+
+  SECTION("std::istream") {
+    std::istringstream stream(input);
+    REQUIRE(deserializeJson(doc, stream) == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == output);
+  }
+
+  SECTION("output of serializeJsonPretty()") {
+    REQUIRE(deserializeJson(doc, input) == DeserializationError::Ok);
+    std::string pretty;
+    serializeJsonPretty(doc, pretty);
+    REQUIRE(deserializeJson(doc, pretty.c_str(), pretty.size()) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == output);
+  }
+
+  SECTION("only spaces") {
+    REQUIRE(deserializeJson(doc, "                              ") ==
+            DeserializationError::IncompleteInput);
+  }
+
+  SECTION("spaces until the end of a bounded input") {
+    REQUIRE(deserializeJson(doc, "[                         ]", 20) ==
+            DeserializationError::IncompleteInput);
+  }
+}
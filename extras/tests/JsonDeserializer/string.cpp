@@ -6,6 +6,9 @@
 #include <ArduinoJson.h>
 #include <catch.hpp>
 
+#include <sstream>
+#include <vector>
+
 TEST_CASE("Valid JSON strings value") {
   struct TestCase {
     const char* input;
@@ -87,3 +90,61 @@ TEST_CASE("Not enough room to duplicate the string") {
             DeserializationError::NoMemory);
   }
 }
+
+TEST_CASE("Long JSON strings") {
+  // long enough to be processed several words at a time
+  std::string input =
+      "\"abcdefghijklmnopqrstuvwxyz\\n0123456789\\\"ABCDEFGHIJ'\\\\KLMNOPQRS\"";
+  std::string output =
+      "abcdefghijklmnopqrstuvwxyz\n0123456789\"ABCDEFGHIJ'\\KLMNOPQRS";
+  DynamicJsonDocument doc(4096);
+
+  SECTION("const char*") {
+    REQUIRE(deserializeJson(doc, input.c_str()) == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == output);
+  }
+
+  SECTION("char*") {
+    std::vector<char> buffer(input.begin(), input.end());
+    buffer.push_back('\0');
+    REQUIRE(deserializeJson(doc, &buffer[0]) == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == output);
+  }
+
+  SECTION("const char*, size_t") {
+    REQUIRE(deserializeJson(doc, input.c_str(), input.size()) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == output);
+  }
+
+  SECTION("std::string") {
+    REQUIRE(deserializeJson(doc, input) == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == output);
+  }
+
+  SECTION("std::istream") {
+    std::istringstream stream(input);
+    REQUIRE(deserializeJson(doc, stream) == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == output);
+  }
+
+  SECTION("stops at the end of a bounded input") {
+    REQUIRE(deserializeJson(doc, input.c_str(), input.size() - 1) ==
+            DeserializationError::IncompleteInput);
+  }
+
+  SECTION("stops at the first '\\0'") {
+    input[40] = '\0';
+    REQUIRE(deserializeJson(doc, input.c_str(), input.size()) ==
+            DeserializationError::IncompleteInput);
+  }
+
+  SECTION("skipped by a filter") {
+    StaticJsonDocument<64> filter;
+    filter["b"] = true;
+    std::string json = "{\"a\":" + input + ",\"b\":" + input + "}";
+    REQUIRE(deserializeJson(doc, json, DeserializationOption::Filter(filter)) ==
+            DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"b\":" + input + "}");
+  }
+}
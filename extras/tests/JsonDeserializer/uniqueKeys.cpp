@@ -0,0 +1,85 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+
+using namespace DeserializationOption;
+
+TEST_CASE("deserializeJson(..., UniqueKeys)") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("Nested objects") {
+    DeserializationError err = deserializeJson(
+        doc, "{\"a\":1,\"b\":{\"c\":[{\"d\":2},3]},\"e\":\"f\"}", UniqueKeys());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() ==
+            "{\"a\":1,\"b\":{\"c\":[{\"d\":2},3]},\"e\":\"f\"}");
+    REQUIRE(doc["b"]["c"][0]["d"] == 2);
+  }
+
+  SECTION("Duplicate keys are not merged") {
+    DeserializationError err =
+        deserializeJson(doc, "{\"a\":1,\"a\":2}", UniqueKeys());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.size() == 2);
+    REQUIRE(doc.as<std::string>() == "{\"a\":1,\"a\":2}");
+  }
+
+  SECTION("Duplicate keys are merged by default") {
+    DeserializationError err = deserializeJson(doc, "{\"a\":1,\"a\":2}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"a\":2}");
+  }
+
+  SECTION("NestingLimit") {
+    REQUIRE(deserializeJson(doc, "{\"a\":{}}", UniqueKeys(), NestingLimit(1)) ==
+            DeserializationError::TooDeep);
+    REQUIRE(deserializeJson(doc, "{\"a\":{}}", NestingLimit(1), UniqueKeys()) ==
+            DeserializationError::TooDeep);
+  }
+}
+
+TEST_CASE("UniqueKeys overloads") {
+  StaticJsonDocument<256> doc;
+
+  SECTION("const char*, UniqueKeys") {
+    deserializeJson(doc, "{}", UniqueKeys());
+  }
+
+  SECTION("const char*, size_t, UniqueKeys") {
+    deserializeJson(doc, "{}", 2, UniqueKeys());
+  }
+
+  SECTION("const std::string&, UniqueKeys") {
+    deserializeJson(doc, std::string("{}"), UniqueKeys());
+  }
+
+  SECTION("std::istream&, UniqueKeys") {
+    std::stringstream s("{}");
+    deserializeJson(doc, s, UniqueKeys());
+  }
+
+  SECTION("const char*, size_t, UniqueKeys, NestingLimit") {
+    deserializeJson(doc, "{}", 2, UniqueKeys(), NestingLimit(5));
+  }
+
+  SECTION("const std::string&, NestingLimit, UniqueKeys") {
+    deserializeJson(doc, std::string("{}"), NestingLimit(5), UniqueKeys());
+  }
+
+  SECTION("std::istream&, NestingLimit, UniqueKeys") {
+    std::stringstream s("{}");
+    deserializeJson(doc, s, NestingLimit(5), UniqueKeys());
+  }
+
+  SECTION("const char*, size_t, NestingLimit, UniqueKeys") {
+    deserializeJson(doc, "{}", 2, NestingLimit(5), UniqueKeys());
+  }
+}
@@ -0,0 +1,179 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#include <ArduinoJson.h>
+#include <stdlib.h>  // malloc, free
+#include <catch.hpp>
+#include <string>
+
+class CountingAllocator {
+ public:
+  CountingAllocator(int& count) : _count(&count) {}
+
+  void* allocate(size_t n) {
+    ++*_count;
+    return malloc(n);
+  }
+
+  void deallocate(void* p) {
+    --*_count;
+    free(p);
+  }
+
+ private:
+  int* _count;
+};
+
+class SwitchableAllocator {
+ public:
+  SwitchableAllocator(bool& enabled) : _enabled(&enabled) {}
+
+  void* allocate(size_t n) {
+    return *_enabled ? malloc(n) : 0;
+  }
+
+  void deallocate(void* p) {
+    free(p);
+  }
+
+ private:
+  bool* _enabled;
+};
+
+typedef BasicJsonDocumentPool<CountingAllocator> CountingPool;
+
+TEST_CASE("JsonDocumentPool") {
+  SECTION("acquire() returns an empty document") {
+    JsonDocumentPool pool;
+    REQUIRE(pool.reserve(256, 1));
+
+    JsonDocumentPool::Document* doc = pool.acquire(100);
+    REQUIRE(doc != 0);
+    REQUIRE(doc->isNull());
+    REQUIRE(doc->capacity() == 256);
+    pool.release(doc);
+  }
+
+  SECTION("release() clears the document") {
+    JsonDocumentPool pool;
+    pool.reserve(256, 1);
+
+    JsonDocumentPool::Document* doc = pool.acquire(256);
+    (*doc)["hello"] = std::string("world");
+    pool.release(doc);
+
+    doc = pool.acquire(256);
+    REQUIRE(doc->isNull());
+    REQUIRE(doc->memoryUsage() == 0);
+    pool.release(doc);
+  }
+
+  SECTION("acquire() picks the smallest class that fits") {
+    JsonDocumentPool pool;
+    pool.reserve(1024, 1);
+    pool.reserve(64, 1);
+    pool.reserve(256, 1);
+
+    JsonDocumentPool::Document* a = pool.acquire(65);
+    JsonDocumentPool::Document* b = pool.acquire(1);
+    JsonDocumentPool::Document* c = pool.acquire(300);
+    REQUIRE(a->capacity() == 256);
+    REQUIRE(b->capacity() == 64);
+    REQUIRE(c->capacity() == 1024);
+    REQUIRE(pool.acquire(2000) == 0);
+
+    pool.release(a);
+    pool.release(b);
+    pool.release(c);
+    REQUIRE(pool.available(64) == 1);
+    REQUIRE(pool.available(256) == 1);
+    REQUIRE(pool.available(1024) == 1);
+  }
+
+  SECTION("acquire() and release() don't allocate") {
+    int allocations = 0;
+    {
+      CountingPool pool((CountingAllocator(allocations)));
+      REQUIRE(pool.reserve(128, 2));
+      REQUIRE(allocations == 4);  // a document and its buffer, twice
+
+      for (int i = 0; i < 10; i++) {
+        CountingPool::Document* a = pool.acquire(128);
+        CountingPool::Document* b = pool.acquire(128);
+        a->add(i);
+        b->add(i);
+        pool.release(b);
+        pool.release(a);
+      }
+      REQUIRE(allocations == 4);
+    }
+    REQUIRE(allocations == 0);
+  }
+
+  SECTION("acquire() allocates when the class is empty") {
+    int allocations = 0;
+    {
+      CountingPool pool((CountingAllocator(allocations)));
+      pool.reserve(128, 1);
+
+      CountingPool::Document* a = pool.acquire(128);
+      CountingPool::Document* b = pool.acquire(128);
+      REQUIRE(b != 0);
+      REQUIRE(allocations == 4);
+
+      pool.release(a);
+      pool.release(b);
+      REQUIRE(pool.available(128) == 2);
+    }
+    REQUIRE(allocations == 0);
+  }
+
+  SECTION("release() drops a document that shrinkToFit() made smaller") {
+    JsonDocumentPool pool;
+    pool.reserve(256, 1);
+
+    JsonDocumentPool::Document* doc = pool.acquire(256);
+    doc->add(42);
+    doc->shrinkToFit();
+    REQUIRE(doc->capacity() < 256);
+    pool.release(doc);
+    REQUIRE(pool.available(256) == 0);
+
+    doc = pool.acquire(256);
+    REQUIRE(doc != 0);
+    REQUIRE(doc->capacity() == 256);
+    pool.release(doc);
+    REQUIRE(pool.available(256) == 1);
+  }
+
+  SECTION("reserve() fails after documentPoolClasses capacities") {
+    JsonDocumentPool pool;
+    REQUIRE(pool.reserve(16, 0));
+    REQUIRE(pool.reserve(32, 0));
+    REQUIRE(pool.reserve(64, 0));
+    REQUIRE(pool.reserve(128, 0));
+    REQUIRE(pool.reserve(256, 0) == false);
+    REQUIRE(pool.reserve(64, 1));
+  }
+
+  SECTION("reserve() fails when the allocator fails") {
+    bool enabled = false;
+    BasicJsonDocumentPool<SwitchableAllocator> pool(
+        (SwitchableAllocator(enabled)));
+
+    REQUIRE(pool.reserve(128, 1) == false);
+    REQUIRE(pool.acquire(128) == 0);
+
+    enabled = true;
+    BasicJsonDocumentPool<SwitchableAllocator>::Document* doc =
+        pool.acquire(128);
+    REQUIRE(doc != 0);
+    pool.release(doc);
+  }
+
+  SECTION("release(NULL) does nothing") {
+    JsonDocumentPool pool;
+    pool.release(0);
+  }
+}
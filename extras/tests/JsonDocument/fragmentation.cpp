@@ -0,0 +1,49 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("JsonDocument::fragmentation()") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("empty document") {
+    REQUIRE(doc.fragmentation() == 0);
+  }
+
+  SECTION("no garbage") {
+    doc["hello"] = std::string("world");
+    doc["values"].add(42);
+
+    REQUIRE(doc.fragmentation() == 0);
+  }
+
+  SECTION("replaced string") {
+    doc["a"] = std::string("0123456789abcde");
+    doc["a"] = std::string("0123456789abcde");
+
+    REQUIRE(doc.fragmentation() > 0);
+
+    doc.garbageCollect();
+    REQUIRE(doc.fragmentation() == 0);
+  }
+
+  SECTION("removed values") {
+    for (int i = 0; i < 8; i++) doc.add(i);
+    for (int i = 0; i < 6; i++) doc.remove(0);
+
+    REQUIRE(doc.fragmentation() == 75);
+
+    doc.garbageCollect();
+    REQUIRE(doc.fragmentation() == 0);
+  }
+
+  SECTION("strings in the input") {
+    char input[] = "{\"hello\":\"world\"}";
+    deserializeJson(doc, input);
+
+    REQUIRE(doc.fragmentation() == 0);
+  }
+}
@@ -0,0 +1,114 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <string>
+
+static std::string toJson(const JsonDocument& doc) {
+  std::string json;
+  serializeJson(doc, json);
+  return json;
+}
+
+TEST_CASE("JsonDocument::garbageCollect()") {
+  StaticJsonDocument<1024> doc;
+
+  SECTION("frees the replaced strings") {
+    doc["hello"] = std::string("world");
+    doc["hello"] = std::string("there");
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1) + 12);
+
+    doc.garbageCollect();
+
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1) + 6);
+    REQUIRE(toJson(doc) == "{\"hello\":\"there\"}");
+  }
+
+  SECTION("frees the removed values") {
+    deserializeJson(doc, "{\"a\":[1,2,{\"b\":\"c\"}],\"d\":\"e\",\"f\":[3]}");
+    doc.remove("a");
+    doc["f"].add("g");
+
+    doc.garbageCollect();
+
+    REQUIRE(doc.memoryUsage() ==
+            JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(2) + 6);
+    REQUIRE(toJson(doc) == "{\"d\":\"e\",\"f\":[3,\"g\"]}");
+  }
+
+  SECTION("keeps the strings that are not in the order of the values") {
+    doc["z"] = std::string("last");
+    doc["y"] = std::string("middle");
+    doc["x"] = std::string("first");
+    doc["z"] = std::string("LAST");
+    doc.remove("y");
+    doc["y"] = std::string("MIDDLE");
+    doc["x"] = std::string("FIRST");
+
+    doc.garbageCollect();
+
+    REQUIRE(toJson(doc) == "{\"z\":\"LAST\",\"x\":\"FIRST\",\"y\":\"MIDDLE\"}");
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(3) + 18);
+  }
+
+  SECTION("moves raw values") {
+    doc["raw"] = serialized(std::string("[1,2]"));
+    doc["str"] = std::string("hello");
+    doc["raw"] = serialized(std::string("[3]"));
+
+    doc.garbageCollect();
+
+    REQUIRE(toJson(doc) == "{\"raw\":[3],\"str\":\"hello\"}");
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(2) + 9);
+  }
+
+  SECTION("keeps a string at the root") {
+    doc.set(std::string("hello"));
+    doc.set(std::string("world"));
+
+    doc.garbageCollect();
+
+    REQUIRE(doc.as<std::string>() == "world");
+    REQUIRE(doc.memoryUsage() == 6);
+  }
+
+  SECTION("leaves the input strings alone") {
+    char json[] = "{\"hello\":\"world\",\"answer\":42}";
+    deserializeJson(doc, json);
+    doc["answer"] = std::string("forty-two");
+
+    doc.garbageCollect();
+
+    REQUIRE(toJson(doc) == "{\"hello\":\"world\",\"answer\":\"forty-two\"}");
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(2) + 10);
+  }
+
+  SECTION("works when the pool is full") {
+    StaticJsonDocument<JSON_OBJECT_SIZE(16) + 256> full;
+    for (int i = 0; i < 16; i++) full[std::string(1, char('a' + i))] = i;
+    for (int i = 0; full.memoryUsage() + 4 <= full.capacity(); i++)
+      full[std::string(1, char('a' + i % 16))] = std::string("xyz");
+
+    full.garbageCollect();
+
+    REQUIRE(full.memoryUsage() == JSON_OBJECT_SIZE(16) + 16 * 2 + 16 * 4);
+    for (int i = 0; i < 16; i++)
+      REQUIRE(full[std::string(1, char('a' + i))] == "xyz");
+  }
+
+  SECTION("the document remains usable") {
+    deserializeJson(doc, "[[1,2,3],{\"a\":1,\"b\":2}]");
+    doc[0].as<JsonArray>().remove(1);
+    doc[1].remove("a");
+
+    doc.garbageCollect();
+    doc[0].add(4);
+    doc[1]["c"] = 3;
+    doc.add(std::string("five"));
+
+    REQUIRE(toJson(doc) == "[[1,3,4],{\"b\":2,\"c\":3},\"five\"]");
+  }
+}
@@ -83,4 +83,31 @@ TEST_CASE("JsonVariant::set(JsonVariant)") {
     REQUIRE(doc1.memoryUsage() == JSON_STRING_SIZE(8));
     REQUIRE(doc2.memoryUsage() == JSON_STRING_SIZE(8));
   }
+
+  SECTION("stores MsgPackBinary by copy") {
+    char data[] = "\x00\x01\x02";
+    var1.set(MsgPackBinary(data, 3));
+    var2.set(var1);
+    data[0] = 'X';
+
+    REQUIRE(doc1.memoryUsage() == JSON_STRING_SIZE(3));
+    REQUIRE(doc2.memoryUsage() == JSON_STRING_SIZE(3));
+    REQUIRE(var2.as<MsgPackBinary>().size() == 3);
+    REQUIRE(var2.as<MsgPackBinary>().data()[0] == 0);
+    REQUIRE(var1 == var2);
+  }
+
+  SECTION("stores MsgPackExtension by copy") {
+    char data[] = "\x00\x01\x02";
+    var1.set(MsgPackExtension(42, data, 3));
+    var2.set(var1);
+    data[0] = 'X';
+
+    REQUIRE(doc1.memoryUsage() == JSON_STRING_SIZE(4));
+    REQUIRE(doc2.memoryUsage() == JSON_STRING_SIZE(4));
+    REQUIRE(var2.as<MsgPackExtension>().type() == 42);
+    REQUIRE(var2.as<MsgPackExtension>().size() == 3);
+    REQUIRE(var2.as<MsgPackExtension>().data()[0] == 0);
+    REQUIRE(var1 == var2);
+  }
 }
@@ -152,6 +152,28 @@ TEST_CASE("JsonVariant::is()") {
     testString("42");
   }
 
+  SECTION("MsgPackBinary") {
+    DynamicJsonDocument doc(4096);
+    JsonVariant var = doc.to<JsonVariant>();
+    var.set(MsgPackBinary("\x01\x02", 2));
+
+    REQUIRE(var.is<MsgPackBinary>());
+    REQUIRE_FALSE(var.is<MsgPackExtension>());
+    REQUIRE_FALSE(var.is<const char *>());
+    REQUIRE_FALSE(var.is<JsonArray>());
+  }
+
+  SECTION("MsgPackExtension") {
+    DynamicJsonDocument doc(4096);
+    JsonVariant var = doc.to<JsonVariant>();
+    var.set(MsgPackExtension(1, "\x01\x02", 2));
+
+    REQUIRE(var.is<MsgPackExtension>());
+    REQUIRE_FALSE(var.is<MsgPackBinary>());
+    REQUIRE_FALSE(var.is<const char *>());
+    REQUIRE(JsonVariantConst(var).is<MsgPackExtension>());
+  }
+
   SECTION("null") {
     DynamicJsonDocument doc(4096);
     deserializeJson(doc, "[null]");
@@ -0,0 +1,118 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string.h>
+
+using namespace ARDUINOJSON_NAMESPACE;
+
+typedef BasicJsonDocument<AllocatorRef<MonotonicArena> > ArenaJsonDocument;
+
+TEST_CASE("MonotonicArena") {
+  char buffer[1024];
+  MonotonicArena arena(buffer, sizeof(buffer));
+
+  SECTION("allocate() returns aligned blocks") {
+    void* a = arena.allocate(3);
+    void* b = arena.allocate(5);
+
+    REQUIRE(a != 0);
+    REQUIRE(b != 0);
+    REQUIRE(a != b);
+    REQUIRE(isAligned(a));
+    REQUIRE(isAligned(b));
+  }
+
+  SECTION("allocate() returns NULL when full") {
+    REQUIRE(arena.allocate(950) != 0);
+    REQUIRE(arena.allocate(100) == 0);
+  }
+
+  SECTION("deallocate() frees the last block") {
+    arena.allocate(16);
+    size_t size = arena.size();
+    void* p = arena.allocate(100);
+
+    arena.deallocate(p);
+
+    REQUIRE(arena.size() == size);
+    REQUIRE(arena.allocate(100) == p);
+  }
+
+  SECTION("deallocate() ignores the other blocks") {
+    void* p = arena.allocate(16);
+    arena.allocate(100);
+    size_t size = arena.size();
+
+    arena.deallocate(p);
+
+    REQUIRE(arena.size() == size);
+  }
+
+  SECTION("reallocate() resizes the last block") {
+    void* p = arena.allocate(100);
+    size_t header = arena.size() - 100;
+
+    REQUIRE(arena.reallocate(p, 500) == p);
+    REQUIRE(arena.size() == header + 500);
+    REQUIRE(arena.reallocate(p, 50) == p);
+    REQUIRE(arena.size() == header + 50);
+    REQUIRE(arena.reallocate(p, 2000) == 0);
+  }
+
+  SECTION("reallocate() shrinks the other blocks in place") {
+    void* p = arena.allocate(100);
+    arena.allocate(16);
+    size_t size = arena.size();
+
+    REQUIRE(arena.reallocate(p, 50) == p);
+    REQUIRE(arena.size() == size);
+  }
+
+  SECTION("reallocate() moves the other blocks to grow them") {
+    char* p = static_cast<char*>(arena.allocate(10));
+    char* q = static_cast<char*>(arena.allocate(10));
+    strcpy(p, "hello");
+    strcpy(q, "world");
+
+    char* bigger = static_cast<char*>(arena.reallocate(p, 100));
+
+    REQUIRE(bigger != 0);
+    REQUIRE(bigger != p);
+    REQUIRE(strcmp(bigger, "hello") == 0);
+    REQUIRE(strcmp(q, "world") == 0);
+    REQUIRE(arena.reallocate(q, 1000) == 0);
+  }
+
+  SECTION("reset() frees everything") {
+    void* p = arena.allocate(100);
+    arena.allocate(200);
+
+    arena.reset();
+
+    REQUIRE(arena.size() == 0);
+    REQUIRE(arena.allocate(100) == p);
+  }
+
+  SECTION("BasicJsonDocument") {
+    {
+      ArenaJsonDocument doc(256, arena);
+      REQUIRE(doc.capacity() == 256);
+      REQUIRE(arena.size() > 256);
+
+      deserializeJson(doc, "{\"hello\":\"world\"}");
+      doc.shrinkToFit();
+
+      REQUIRE(doc["hello"] == "world");
+      REQUIRE(arena.size() < 64);
+    }
+    REQUIRE(arena.size() == 0);
+  }
+
+  SECTION("BasicJsonDocument is full") {
+    ArenaJsonDocument doc(2048, arena);
+    REQUIRE(doc.capacity() == 0);
+  }
+}
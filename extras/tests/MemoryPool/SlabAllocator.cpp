@@ -0,0 +1,87 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string.h>
+
+using namespace ARDUINOJSON_NAMESPACE;
+
+typedef BasicJsonDocument<AllocatorRef<SlabAllocator> > SlabJsonDocument;
+
+TEST_CASE("SlabAllocator") {
+  char buffer[4096];
+  SlabAllocator slab(buffer, sizeof(buffer));
+
+  SECTION("allocate() returns aligned blocks") {
+    void* a = slab.allocate(3);
+    void* b = slab.allocate(5);
+
+    REQUIRE(a != 0);
+    REQUIRE(b != 0);
+    REQUIRE(a != b);
+    REQUIRE(isAligned(a));
+    REQUIRE(isAligned(b));
+  }
+
+  SECTION("allocate() returns NULL when full") {
+    REQUIRE(slab.allocate(3000) != 0);
+    REQUIRE(slab.allocate(3000) == 0);
+  }
+
+  SECTION("allocate() reuses the freed blocks of the same size") {
+    void* a = slab.allocate(100);
+    void* b = slab.allocate(100);
+    slab.deallocate(a);
+    slab.deallocate(b);
+
+    REQUIRE(slab.allocate(120) == b);
+    REQUIRE(slab.allocate(200) != a);
+    REQUIRE(slab.allocate(100) == a);
+  }
+
+  SECTION("allocate() can't return blocks larger than the largest class") {
+    REQUIRE(slab.allocate(slabBlockSize(slabClasses)) == 0);
+  }
+
+  SECTION("deallocate(NULL)") {
+    slab.deallocate(0);
+  }
+
+  SECTION("reallocate() keeps the block when it's large enough") {
+    void* p = slab.allocate(100);
+
+    REQUIRE(slab.reallocate(p, 10) == p);
+    REQUIRE(slab.reallocate(p, 110) == p);
+  }
+
+  SECTION("reallocate() moves the content to a larger block") {
+    char* p = static_cast<char*>(slab.allocate(10));
+    strcpy(p, "hello");
+
+    char* q = static_cast<char*>(slab.reallocate(p, 500));
+
+    REQUIRE(q != 0);
+    REQUIRE(q != p);
+    REQUIRE(strcmp(q, "hello") == 0);
+    REQUIRE(slab.allocate(10) == p);
+  }
+
+  SECTION("BasicJsonDocument") {
+    void* p;
+    {
+      SlabJsonDocument doc(256, slab);
+      REQUIRE(doc.capacity() == 256);
+
+      deserializeJson(doc, "{\"hello\":\"world\"}");
+      doc.shrinkToFit();
+      REQUIRE(doc["hello"] == "world");
+
+      p = slab.allocate(256);
+      slab.deallocate(p);
+    }
+    REQUIRE(slab.allocate(256) != 0);
+    REQUIRE(slab.allocate(256) == p);
+  }
+}
@@ -32,6 +32,11 @@ TEST_CASE("MemoryPool::allocFrozenString()") {
     REQUIRE(0 == p);
   }
 
+  SECTION("Returns NULL when the size is close to SIZE_MAX") {
+    REQUIRE(0 == pool.allocFrozenString(size_t(-1)));
+    REQUIRE(0 == pool.allocFrozenString(size_t(-1) - 15));
+  }
+
   SECTION("Returns NULL when buffer is NULL") {
     MemoryPool pool2(0, poolCapacity);
     REQUIRE(0 == pool2.allocFrozenString(2));
@@ -47,6 +47,48 @@ TEST_CASE("Reader<std::istringstream>") {
     REQUIRE(buffer[5] == 'F');
     REQUIRE(buffer[6] == 'g');
   }
+
+  SECTION("skip()") {
+    std::istringstream src("ABCDEF");
+    Reader<std::istringstream> reader(src);
+
+    REQUIRE(reader.skip(2) == 2);
+    REQUIRE(reader.read() == 'C');
+    REQUIRE(reader.skip(0) == 0);
+    REQUIRE(reader.read() == 'D');
+  }
+
+  SECTION("skip() past the end") {
+    std::istringstream src("ABCDEF");
+    Reader<std::istringstream> reader(src);
+
+    REQUIRE(reader.skip(8) == 6);
+    REQUIRE(reader.read() == -1);
+  }
+}
+
+// A stream buffer that doesn't support seeking, like a pipe or a socket
+class NonSeekableBuffer : public std::streambuf {
+ public:
+  NonSeekableBuffer(const std::string& s) : _s(s) {
+    setg(&_s[0], &_s[0], &_s[0] + _s.size());
+  }
+
+ private:
+  std::string _s;
+};
+
+TEST_CASE("Reader<std::istream>") {
+  SECTION("skip() when the stream can't seek") {
+    NonSeekableBuffer buf(std::string(100, 'x') + "ABC");
+    std::istream src(&buf);
+    Reader<std::istream> reader(src);
+
+    REQUIRE(reader.skip(101) == 101);
+    REQUIRE(reader.read() == 'B');
+    REQUIRE(reader.skip(8) == 1);
+    REQUIRE(reader.read() == -1);
+  }
 }
 
 TEST_CASE("BoundedReader<const char*>") {
@@ -85,6 +127,22 @@ TEST_CASE("BoundedReader<const char*>") {
     REQUIRE(buffer[5] == 'F');
     REQUIRE(buffer[6] == 'g');
   }
+
+  SECTION("skip()") {
+    BoundedReader<const char*> reader("ABCDEFGH", 6);
+
+    REQUIRE(reader.skip(2) == 2);
+    REQUIRE(reader.read() == 'C');
+    REQUIRE(reader.skip(0) == 0);
+    REQUIRE(reader.read() == 'D');
+  }
+
+  SECTION("skip() past the end") {
+    BoundedReader<const char*> reader("ABCDEFGH", 6);
+
+    REQUIRE(reader.skip(8) == 6);
+    REQUIRE(reader.read() == -1);
+  }
 }
 
 TEST_CASE("Reader<const char*>") {
@@ -123,6 +181,15 @@ TEST_CASE("Reader<const char*>") {
     REQUIRE(buffer[5] == 'F');
     REQUIRE(buffer[6] == 'g');
   }
+
+  SECTION("skip()") {
+    Reader<const char*> reader("ABCDEF");
+
+    REQUIRE(reader.skip(2) == 2);
+    REQUIRE(reader.read() == 'C');
+    REQUIRE(reader.skip(0) == 0);
+    REQUIRE(reader.read() == 'D');
+  }
 }
 
 TEST_CASE("IteratorReader") {
@@ -164,6 +231,24 @@ TEST_CASE("IteratorReader") {
     REQUIRE(buffer[5] == 'F');
     REQUIRE(buffer[6] == 'g');
   }
+
+  SECTION("skip()") {
+    std::string src("ABCDEF");
+    IteratorReader<std::string::const_iterator> reader(src.begin(), src.end());
+
+    REQUIRE(reader.skip(2) == 2);
+    REQUIRE(reader.read() == 'C');
+    REQUIRE(reader.skip(0) == 0);
+    REQUIRE(reader.read() == 'D');
+  }
+
+  SECTION("skip() past the end") {
+    std::string src("ABCDEF");
+    IteratorReader<std::string::const_iterator> reader(src.begin(), src.end());
+
+    REQUIRE(reader.skip(8) == 6);
+    REQUIRE(reader.read() == -1);
+  }
 }
 
 class StreamStub : public Stream {
@@ -222,4 +307,32 @@ TEST_CASE("Reader<Stream>") {
     REQUIRE(buffer[5] == 'F');
     REQUIRE(buffer[6] == 'g');
   }
+
+  SECTION("skip()") {
+    StreamStub src("ABCDEF");
+    Reader<StreamStub> reader(src);
+
+    REQUIRE(reader.skip(2) == 2);
+    REQUIRE(reader.read() == 'C');
+    REQUIRE(reader.skip(0) == 0);
+    REQUIRE(reader.read() == 'D');
+  }
+
+  SECTION("skip() past the end") {
+    StreamStub src("ABCDEF");
+    Reader<StreamStub> reader(src);
+
+    REQUIRE(reader.skip(8) == 6);
+    REQUIRE(reader.read() == -1);
+  }
+
+  SECTION("skip() more than one block") {
+    StreamStub src(std::string(100, 'x').append("ABC").c_str());
+    Reader<StreamStub> reader(src);
+
+    REQUIRE(reader.skip(101) == 101);
+    REQUIRE(reader.read() == 'B');
+    REQUIRE(reader.skip(200) == 1);
+    REQUIRE(reader.read() == -1);
+  }
 }
@@ -0,0 +1,71 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#define ARDUINOJSON_CACHE_COLLECTION_SIZE 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_CACHE_COLLECTION_SIZE == 1") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("JsonArray") {
+    JsonArray arr = doc.to<JsonArray>();
+    REQUIRE(arr.size() == 0);
+
+    arr.add(1);
+    arr.add(2);
+    arr[4] = 5;
+    REQUIRE(arr.size() == 5);
+
+    arr.remove(0);
+    REQUIRE(arr.size() == 4);
+
+    arr = doc.to<JsonArray>();
+    REQUIRE(arr.size() == 0);
+  }
+
+  SECTION("JsonObject") {
+    JsonObject obj = doc.to<JsonObject>();
+
+    obj["a"] = 1;
+    obj["b"] = 2;
+    obj["a"] = 3;
+    REQUIRE(obj.size() == 2);
+
+    obj.remove("a");
+    obj.remove("z");
+    REQUIRE(obj.size() == 1);
+  }
+
+  SECTION("Failed allocation") {
+    StaticJsonDocument<JSON_OBJECT_SIZE(1)> small;
+    JsonObject obj = small.to<JsonObject>();
+
+    obj["a"] = 1;
+    obj[std::string("b")] = 2;
+
+    REQUIRE(obj.size() == 1);
+  }
+
+  SECTION("Deserializers") {
+    deserializeJson(doc, "{\"a\":[1,2,3],\"b\":{\"c\":4},\"a\":[5]}");
+    REQUIRE(doc.size() == 2);
+    REQUIRE(doc["a"].size() == 1);
+
+    std::string msgpack;
+    serializeMsgPack(doc, msgpack);
+    deserializeMsgPack(doc, msgpack);
+    REQUIRE(doc.size() == 2);
+    REQUIRE(doc["b"].size() == 1);
+  }
+
+  SECTION("Copy") {
+    deserializeJson(doc, "[1,[2,3],{\"a\":4}]");
+    DynamicJsonDocument copy(doc);
+
+    REQUIRE(copy.size() == 3);
+    REQUIRE(copy[1].size() == 2);
+  }
+}
@@ -9,3 +9,11 @@ TEST_CASE("ARDUINOJSON_DECODE_UNICODE == 1") {
 
   REQUIRE(err == DeserializationError::Ok);
 }
+
+TEST_CASE("measureJsonCapacity() with ARDUINOJSON_DECODE_UNICODE == 1") {
+  DynamicJsonDocument doc(2048);
+  const char* input = "[\"\\u0041\\u00e9\\u20ac\\uD834\\uDD1E\"]";
+  deserializeJson(doc, input);
+
+  REQUIRE(measureJsonCapacity(input) == doc.memoryUsage());
+}
@@ -403,3 +403,26 @@ TEST_CASE("Comments alone") {
     REQUIRE(err == DeserializationError::IncompleteInput);
   }
 }
+
+TEST_CASE("Comments between long runs of spaces") {
+  DynamicJsonDocument doc(2048);
+
+  SECTION("const char*") {
+    DeserializationError err = deserializeJson(
+        doc, "[                /* a */                1,\n"
+             "                 // b\n                   2]");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[1,2]");
+  }
+
+  SECTION("const char*, size_t") {
+    const char* input =
+        "[                /* a */                1,\n"
+        "                 // b\n                   2]";
+    DeserializationError err = deserializeJson(doc, input, strlen(input));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[1,2]");
+  }
+}
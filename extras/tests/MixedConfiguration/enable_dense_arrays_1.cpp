@@ -0,0 +1,103 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#define ARDUINOJSON_ENABLE_DENSE_ARRAYS 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+static void requireElements(JsonArray arr, const int* expected, size_t n) {
+  REQUIRE(arr.size() == n);
+  size_t i = 0;
+  for (JsonArray::iterator it = arr.begin(); it != arr.end(); ++it, ++i) {
+    REQUIRE(*it == expected[i]);
+    REQUIRE(arr[i] == expected[i]);
+  }
+  REQUIRE(arr[n].isNull());
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_DENSE_ARRAYS == 1") {
+  DynamicJsonDocument doc(4096);
+  JsonArray arr = doc.to<JsonArray>();
+
+  SECTION("Empty array") {
+    REQUIRE(arr[0].isNull());
+  }
+
+  SECTION("Adjacent elements") {
+    for (int i = 0; i < 10; i++) arr.add(i);
+
+    const int expected[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    requireElements(arr, expected, 10);
+  }
+
+  SECTION("Nested arrays") {
+    for (int i = 0; i < 3; i++) {
+      JsonArray nested = arr.createNestedArray();
+      nested.add(i);
+      nested.add(i * 10);
+    }
+
+    REQUIRE(arr.size() == 3);
+    REQUIRE(arr[2][1] == 20);
+    REQUIRE(arr[3].isNull());
+    REQUIRE(arr[1][0] == 1);
+  }
+
+  SECTION("Remove first") {
+    for (int i = 0; i < 4; i++) arr.add(i);
+    arr.remove(0);
+
+    const int expected[] = {1, 2, 3};
+    requireElements(arr, expected, 3);
+  }
+
+  SECTION("Remove last, then add") {
+    for (int i = 0; i < 4; i++) arr.add(i);
+    arr.remove(3);
+    arr.add(4);
+
+    const int expected[] = {0, 1, 2, 4};
+    requireElements(arr, expected, 4);
+  }
+
+  SECTION("Remove in the middle, then add") {
+    for (int i = 0; i < 4; i++) arr.add(i);
+    arr.remove(1);
+    arr.add(4);
+
+    const int expected[] = {0, 2, 3, 4};
+    requireElements(arr, expected, 4);
+  }
+
+  SECTION("Set element beyond the end") {
+    arr[3] = 3;
+    arr[1] = 1;
+
+    REQUIRE(arr.size() == 4);
+    REQUIRE(arr[1] == 1);
+    REQUIRE(arr[3] == 3);
+  }
+
+  SECTION("deserializeJson()") {
+    deserializeJson(doc, "[0,[1,2],3,{\"a\":4},5]");
+    arr = doc.as<JsonArray>();
+
+    REQUIRE(arr[0] == 0);
+    REQUIRE(arr[1][1] == 2);
+    REQUIRE(arr[2] == 3);
+    REQUIRE(arr[3]["a"] == 4);
+    REQUIRE(arr[4] == 5);
+    REQUIRE(arr[5].isNull());
+  }
+
+  SECTION("shrinkToFit()") {
+    for (int i = 0; i < 10; i++) arr.add(i);
+    doc.shrinkToFit();
+    arr = doc.as<JsonArray>();
+
+    const int expected[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    requireElements(arr, expected, 10);
+  }
+}
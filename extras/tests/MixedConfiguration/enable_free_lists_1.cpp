@@ -0,0 +1,167 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#define ARDUINOJSON_ENABLE_FREE_LISTS 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_ENABLE_FREE_LISTS == 1") {
+  DynamicJsonDocument doc(4096);
+  const std::string value1(31, '1');
+  const std::string value2(31, '2');
+
+  SECTION("remove() and add() run in constant memory") {
+    StaticJsonDocument<JSON_OBJECT_SIZE(3) + 2 * JSON_STRING_SIZE(32)> small;
+    JsonObject obj = small.to<JsonObject>();
+    obj["a"] = 1;
+    obj["b"] = value1;
+    obj["c"] = value2;
+    const size_t usage = small.memoryUsage();
+
+    for (int i = 0; i < 100; i++) {
+      const char* key = i % 2 ? "b" : "c";
+      obj.remove(key);
+      REQUIRE(small.memoryUsage() ==
+              JSON_OBJECT_SIZE(2) + JSON_STRING_SIZE(32));
+      REQUIRE(obj[key].set(i % 2 ? value1 : value2));
+      REQUIRE(small.memoryUsage() == usage);
+    }
+
+    REQUIRE(obj["a"] == 1);
+    REQUIRE(obj["b"] == value1);
+    REQUIRE(obj["c"] == value2);
+  }
+
+  SECTION("short strings are reused too") {
+    JsonObject obj = doc.to<JsonObject>();
+    obj[std::string("a")] = std::string("x");
+    obj[std::string("b")] = std::string("y");
+    const size_t usage = doc.memoryUsage();
+
+    for (int i = 0; i < 10; i++) {
+      obj.remove("a");
+      obj[std::string("a")] = std::string("x");
+      REQUIRE(doc.memoryUsage() == usage);
+    }
+
+    REQUIRE(doc.as<std::string>() == "{\"b\":\"y\",\"a\":\"x\"}");
+  }
+
+  SECTION("remove() frees the nested values") {
+    JsonArray arr = doc.createNestedArray("a");
+    arr.add(1);
+    arr.add(value1);
+    arr.createNestedObject()["x"] = value2;
+    doc["b"] = 2;
+
+    doc.remove("a");
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1));
+
+    JsonArray arr2 = doc.createNestedArray("c");
+    for (int i = 0; i < 4; i++) arr2.add(i);
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(4));
+    REQUIRE(doc.as<std::string>() == "{\"b\":2,\"c\":[0,1,2,3]}");
+  }
+
+  SECTION("JsonArray::remove()") {
+    JsonArray arr = doc.to<JsonArray>();
+    arr.add(value1);
+    arr.add(value2);
+    arr.add(3);
+
+    arr.remove(arr.begin());
+    arr.remove(0);
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(1));
+
+    arr.add(value2);
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2) + JSON_STRING_SIZE(32));
+    REQUIRE(arr[1] == value2);
+  }
+
+  SECTION("JsonVariant::remove()") {
+    JsonVariant var = doc.createNestedObject("a");
+    var["b"] = value1;
+    var["c"] = value2;
+
+    var.remove("b");
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(2) + JSON_STRING_SIZE(32));
+  }
+
+  SECTION("a freed string is split") {
+    doc["a"] = std::string(63, 'a');
+    doc["z"] = std::string(15, 'z');
+
+    doc.remove("a");
+    doc["b"] = std::string(15, 'b');
+    doc["c"] = std::string(15, 'c');
+
+    REQUIRE(doc.memoryUsage() ==
+            JSON_OBJECT_SIZE(3) + 3 * JSON_STRING_SIZE(16));
+    REQUIRE(doc["b"] == std::string(15, 'b'));
+    REQUIRE(doc["c"] == std::string(15, 'c'));
+    REQUIRE(doc["z"] == std::string(15, 'z'));
+  }
+
+  SECTION("the strings in the input are left alone") {
+    char input[] = "{\"a\":\"a string that stays in the input\",\"b\":1}";
+    deserializeJson(doc, input);
+    const char* s = doc["a"];
+
+    doc.remove("a");
+    doc["c"] = value1;
+
+    REQUIRE(s == std::string("a string that stays in the input"));
+    REQUIRE(doc["c"] == value1);
+  }
+
+  SECTION("garbageCollect() and shrinkToFit() after remove()") {
+    doc["a"] = value1;
+    doc["b"] = value2;
+    doc.remove("a");
+
+    doc.garbageCollect();
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1) + JSON_STRING_SIZE(32));
+
+    doc["c"] = 3;
+    doc.remove("b");
+    doc.shrinkToFit();
+    REQUIRE(doc.as<std::string>() == "{\"c\":3}");
+  }
+
+  SECTION("an empty value doesn't overlap the next string") {
+    doc["a"] = serialized(std::string(""));
+    doc["b"] = std::string("hello world, this is b");
+    doc["c"] = "c";
+    doc.remove("a");
+
+    REQUIRE(doc.as<std::string>() ==
+            "{\"b\":\"hello world, this is b\",\"c\":\"c\"}");
+  }
+
+  SECTION("JSON_STRING_SIZE() and measureJsonCapacity() round up") {
+    const char* input = "{\"ab\":\"cde\"}";
+
+    REQUIRE(JSON_STRING_SIZE(3) == sizeof(void*) + sizeof(size_t));
+    REQUIRE(measureJsonCapacity(input) ==
+            JSON_OBJECT_SIZE(1) + JSON_STRING_SIZE(3) + JSON_STRING_SIZE(4));
+
+    StaticJsonDocument<JSON_OBJECT_SIZE(1) + 2 * JSON_STRING_SIZE(4)> small;
+    REQUIRE(deserializeJson(small, input) == DeserializationError::Ok);
+    REQUIRE(small.memoryUsage() == measureJsonCapacity(input));
+  }
+
+  SECTION("clear() forgets the free lists") {
+    doc["a"] = value1;
+    doc["b"] = value2;
+    doc.remove("a");
+
+    doc.clear();
+    REQUIRE(doc.memoryUsage() == 0);
+
+    doc["c"] = value1;
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1) + JSON_STRING_SIZE(32));
+  }
+}
@@ -0,0 +1,207 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#define ARDUINOJSON_ENABLE_GROWABLE_POOL 1
+#include <ArduinoJson.h>
+
+#include <stdlib.h>  // malloc, free
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+
+using ARDUINOJSON_NAMESPACE::addPadding;
+
+class CountingAllocator {
+ public:
+  void* allocate(size_t n) {
+    if (!enabled)
+      return 0;
+    allocations++;
+    live++;
+    return malloc(n);
+  }
+
+  void deallocate(void* p) {
+    live--;
+    free(p);
+  }
+
+  void* reallocate(void* p, size_t n) {
+    return realloc(p, n);
+  }
+
+  static int allocations;
+  static int live;
+  static bool enabled;
+};
+
+int CountingAllocator::allocations = 0;
+int CountingAllocator::live = 0;
+bool CountingAllocator::enabled = true;
+
+typedef BasicJsonDocument<CountingAllocator> CountingJsonDocument;
+
+static std::string largeJson() {
+  std::ostringstream s;
+  s << '[';
+  for (int i = 0; i < 200; i++) {
+    if (i > 0)
+      s << ',';
+    s << "{\"id\":" << i << ",\"name\":\"item " << i << "\",\"tags\":[\"a"
+      << i << "\",\"b\"]}";
+  }
+  s << ']';
+  return s.str();
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_GROWABLE_POOL == 1") {
+  CountingAllocator::allocations = 0;
+  CountingAllocator::live = 0;
+  CountingAllocator::enabled = true;
+  std::string json = largeJson();
+
+  {
+    CountingJsonDocument doc(128);
+
+    SECTION("deserializeJson() allocates more chunks") {
+      DeserializationError err = deserializeJson(doc, json);
+
+      REQUIRE(err == DeserializationError::Ok);
+      REQUIRE(doc.as<std::string>() == json);
+      REQUIRE(doc.capacity() > 128);
+      REQUIRE(doc.memoryUsage() <= doc.capacity());
+      REQUIRE(CountingAllocator::live > 1);
+    }
+
+    SECTION("deserializeMsgPack() allocates more chunks") {
+      DynamicJsonDocument src(65536);
+      deserializeJson(src, json);
+      std::string msgpack;
+      serializeMsgPack(src, msgpack);
+
+      DeserializationError err = deserializeMsgPack(doc, msgpack);
+
+      REQUIRE(err == DeserializationError::Ok);
+      REQUIRE(doc.as<std::string>() == json);
+    }
+
+    SECTION("A string larger than a chunk") {
+      std::string big(1000, 'x');
+
+      DeserializationError err = deserializeJson(doc, "[\"" + big + "\"]");
+
+      REQUIRE(err == DeserializationError::Ok);
+      REQUIRE(doc[0] == big);
+    }
+
+    SECTION("Add members one by one") {
+      std::ostringstream expected;
+      expected << '{';
+      for (int i = 0; i < 100; i++) {
+        std::ostringstream key;
+        key << "key" << i;
+        doc[key.str()] = i;
+        expected << (i ? "," : "") << '"' << key.str() << "\":" << i;
+      }
+      expected << '}';
+
+      REQUIRE(doc.size() == 100);
+      REQUIRE(doc.as<std::string>() == expected.str());
+    }
+
+    SECTION("shrinkToFit() merges the chunks") {
+      deserializeJson(doc, json);
+
+      doc.shrinkToFit();
+
+      REQUIRE(doc.as<std::string>() == json);
+      REQUIRE(doc.capacity() == addPadding(doc.memoryUsage()));
+      REQUIRE(CountingAllocator::live == 1);
+    }
+
+    SECTION("garbageCollect() merges the chunks") {
+      deserializeJson(doc, json);
+
+      REQUIRE(doc.garbageCollect() == true);
+
+      REQUIRE(doc.as<std::string>() == json);
+      REQUIRE(CountingAllocator::live == 1);
+    }
+
+    SECTION("clear() keeps the total capacity in a single chunk") {
+      deserializeJson(doc, json);
+      size_t capacity = doc.capacity();
+
+      doc.clear();
+
+      REQUIRE(doc.capacity() == capacity);
+      REQUIRE(CountingAllocator::live == 1);
+
+      int allocations = CountingAllocator::allocations;
+      DeserializationError err = deserializeJson(doc, json);
+
+      REQUIRE(err == DeserializationError::Ok);
+      REQUIRE(CountingAllocator::allocations == allocations);
+    }
+
+    SECTION("clear() keeps the chunks when it can't merge them") {
+      deserializeJson(doc, json);
+      size_t capacity = doc.capacity();
+      int live = CountingAllocator::live;
+
+      CountingAllocator::enabled = false;
+      doc.clear();
+
+      REQUIRE(doc.capacity() == capacity);
+      REQUIRE(doc.memoryUsage() == 0);
+      REQUIRE(CountingAllocator::live == live);
+
+      CountingAllocator::enabled = true;
+      DeserializationError err = deserializeJson(doc, json);
+
+      REQUIRE(err == DeserializationError::Ok);
+      REQUIRE(doc.as<std::string>() == json);
+    }
+
+    SECTION("Copy") {
+      deserializeJson(doc, json);
+
+      CountingJsonDocument copy(doc);
+
+      REQUIRE(copy.as<std::string>() == json);
+    }
+
+    SECTION("Copy an empty document, then grow") {
+      CountingJsonDocument empty(0);
+      CountingJsonDocument copy(empty);
+
+      DeserializationError err = deserializeJson(copy, json);
+
+      REQUIRE(err == DeserializationError::Ok);
+      REQUIRE(copy.as<std::string>() == json);
+    }
+
+#if ARDUINOJSON_HAS_RVALUE_REFERENCES
+    SECTION("Move, then grow") {
+      deserializeJson(doc, "[1,2,3]");
+
+      CountingJsonDocument moved(ARDUINOJSON_NAMESPACE::move(doc));
+      for (int i = 0; i < 100; i++) moved.add(i);
+
+      REQUIRE(moved.size() == 103);
+      REQUIRE(moved[102] == 99);
+    }
+#endif
+  }
+
+  REQUIRE(CountingAllocator::live == 0);
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_GROWABLE_POOL and StaticJsonDocument") {
+  StaticJsonDocument<128> doc;
+
+  DeserializationError err = deserializeJson(doc, largeJson());
+
+  REQUIRE(err == DeserializationError::NoMemory);
+}
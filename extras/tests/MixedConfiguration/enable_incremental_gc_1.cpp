@@ -0,0 +1,108 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#define ARDUINOJSON_ENABLE_INCREMENTAL_GC 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+static std::string key(int i) {
+  return std::string("key") + char('a' + i);
+}
+
+static std::string value(int i) {
+  return std::string(size_t(i + 1), char('A' + i));
+}
+
+// Replaces every other member, so that the garbage is everywhere
+static void makeGarbage(JsonDocument& doc) {
+  for (int i = 0; i < 16; i++) doc[key(i)] = value(i);
+  for (int i = 0; i < 16; i += 2) doc[key(i)] = value(i + 1);
+  for (int i = 1; i < 16; i += 4) doc.remove(key(i));
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_INCREMENTAL_GC == 1") {
+  DynamicJsonDocument doc(4096);
+  makeGarbage(doc);
+  const std::string json = doc.as<std::string>();
+
+  DynamicJsonDocument expected(4096);
+  makeGarbage(expected);
+  expected.garbageCollect();
+
+  SECTION("ends like garbageCollect()") {
+    int steps = 0;
+    while (!doc.collectStep(16)) {
+      REQUIRE(doc.as<std::string>() == json);
+      REQUIRE(++steps < 100);
+    }
+
+    REQUIRE(steps > 2);
+    REQUIRE(doc.memoryUsage() == expected.memoryUsage());
+    REQUIRE(doc.as<std::string>() == json);
+    REQUIRE(doc.fragmentation() == 0);
+  }
+
+  SECTION("progresses with maxBytes == 0") {
+    int steps = 0;
+    while (!doc.collectStep(0)) REQUIRE(++steps < 1000);
+
+    REQUIRE(doc.memoryUsage() == expected.memoryUsage());
+    REQUIRE(doc.as<std::string>() == json);
+  }
+
+  SECTION("completes in one step when maxBytes is large") {
+    while (!doc.collectStep(4096)) {
+    }
+
+    REQUIRE(doc.memoryUsage() == expected.memoryUsage());
+    REQUIRE(doc.collectStep(4096) == false);
+  }
+
+  SECTION("the document can change between the steps") {
+    // the collection ends if the steps move more than the changes allocate
+    int i = 0;
+    while (!doc.collectStep(64)) {
+      REQUIRE(i < 100);
+      doc[key(i % 16)] = value(15 - i % 16);
+      expected[key(i % 16)] = value(15 - i % 16);
+      if (i % 3 == 0) {
+        doc.remove(key((i + 5) % 16));
+        expected.remove(key((i + 5) % 16));
+      }
+      i++;
+      REQUIRE(doc.as<std::string>() == expected.as<std::string>());
+    }
+
+    // the changes left garbage, that the next collection frees
+    while (!doc.collectStep(64)) {
+    }
+    expected.garbageCollect();
+    REQUIRE(doc.memoryUsage() == expected.memoryUsage());
+    REQUIRE(doc.as<std::string>() == expected.as<std::string>());
+  }
+
+  SECTION("clear() stops the collection") {
+    while (!doc.collectStep(8) && doc.memoryUsage() == expected.memoryUsage()) {
+    }
+    doc.collectStep(8);
+    doc.clear();
+    makeGarbage(doc);
+
+    while (!doc.collectStep(8)) {
+    }
+    REQUIRE(doc.memoryUsage() == expected.memoryUsage());
+    REQUIRE(doc.as<std::string>() == json);
+  }
+
+  SECTION("garbageCollect() completes the collection") {
+    doc.collectStep(8);
+    doc.collectStep(8);
+    doc.garbageCollect();
+
+    REQUIRE(doc.memoryUsage() == expected.memoryUsage());
+    REQUIRE(doc.as<std::string>() == json);
+  }
+}
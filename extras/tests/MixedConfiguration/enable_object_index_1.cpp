@@ -0,0 +1,145 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#define ARDUINOJSON_ENABLE_OBJECT_INDEX 1
+#define ARDUINOJSON_OBJECT_INDEX_THRESHOLD 4
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+
+static std::string key(int i) {
+  std::ostringstream s;
+  s << "key" << i;
+  return s.str();
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_OBJECT_INDEX == 1") {
+  DynamicJsonDocument doc(16384);
+  JsonObject obj = doc.to<JsonObject>();
+
+  for (int i = 0; i < 100; i++) obj[key(i)] = i;
+
+  SECTION("getMember()") {
+    for (int i = 0; i < 100; i++) REQUIRE(obj[key(i)] == i);
+    REQUIRE(obj["key100"].isNull());
+    REQUIRE(obj[static_cast<const char*>(0)].isNull());
+  }
+
+  SECTION("containsKey()") {
+    REQUIRE(obj.containsKey("key0") == true);
+    REQUIRE(obj.containsKey(std::string("key99")) == true);
+    REQUIRE(obj.containsKey("key100") == false);
+  }
+
+  SECTION("getOrAddMember()") {
+    obj["key42"] = "forty-two";
+    obj["key100"] = 100;
+
+    REQUIRE(obj.size() == 101);
+    REQUIRE(obj["key42"] == "forty-two");
+    REQUIRE(obj["key100"] == 100);
+  }
+
+  SECTION("remove()") {
+    for (int i = 0; i < 100; i += 3) obj.remove(key(i));
+
+    REQUIRE(obj.size() == 66);
+    for (int i = 0; i < 100; i++) {
+      REQUIRE(obj.containsKey(key(i)) == (i % 3 != 0));
+    }
+  }
+
+  SECTION("remove() all, then add again") {
+    for (int i = 0; i < 100; i++) obj.remove(key(i));
+    REQUIRE(obj.size() == 0);
+
+    obj["hello"] = "world";
+
+    REQUIRE(obj.size() == 1);
+    REQUIRE(obj["hello"] == "world");
+    REQUIRE(obj.containsKey("key1") == false);
+  }
+
+  SECTION("remove(iterator)") {
+    obj.remove(obj.begin());
+
+    REQUIRE(obj.size() == 99);
+    REQUIRE(obj.containsKey("key0") == false);
+    REQUIRE(obj["key1"] == 1);
+  }
+
+  SECTION("clear()") {
+    obj.clear();
+
+    REQUIRE(obj.size() == 0);
+    REQUIRE(obj.containsKey("key1") == false);
+  }
+
+  SECTION("copy") {
+    DynamicJsonDocument copy(doc);
+    JsonObject copyObj = copy.as<JsonObject>();
+
+    REQUIRE(copy == doc);
+    for (int i = 0; i < 100; i++) REQUIRE(copyObj[key(i)] == i);
+  }
+
+  SECTION("shrinkToFit()") {
+    doc.shrinkToFit();
+    obj = doc.as<JsonObject>();
+
+    for (int i = 0; i < 100; i++) REQUIRE(obj[key(i)] == i);
+    REQUIRE(obj.containsKey("key100") == false);
+  }
+
+  SECTION("memoryUsage()") {
+    REQUIRE(obj.memoryUsage() > JSON_OBJECT_SIZE(100));
+  }
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_OBJECT_INDEX when the pool is full") {
+  StaticJsonDocument<JSON_OBJECT_SIZE(20)> doc;
+  JsonObject obj = doc.to<JsonObject>();
+
+  int n = 0;
+  while (obj[key(n)].set(n)) n++;
+
+  REQUIRE(n > 4);
+  for (int i = 0; i < n; i++) REQUIRE(obj[key(i)] == i);
+  REQUIRE(obj.containsKey(key(n)) == false);
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_OBJECT_INDEX in deserializers") {
+  std::ostringstream s;
+  s << '{';
+  for (int i = 0; i < 100; i++) s << '"' << key(i) << "\":" << i << ',';
+  s << "\"key7\":\"dup\"}";
+
+  DynamicJsonDocument doc(16384);
+
+  SECTION("deserializeJson() merges duplicate keys") {
+    DeserializationError err = deserializeJson(doc, s.str());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.size() == 100);
+    REQUIRE(doc["key7"] == "dup");
+    REQUIRE(doc["key99"] == 99);
+  }
+
+  SECTION("deserializeMsgPack()") {
+    DeserializationError err = deserializeJson(doc, s.str());
+    REQUIRE(err == DeserializationError::Ok);
+    std::string msgpack;
+    serializeMsgPack(doc, msgpack);
+    doc.clear();
+
+    err = deserializeMsgPack(doc, msgpack);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.size() == 100);
+    REQUIRE(doc["key7"] == "dup");
+    REQUIRE(doc["key99"] == 99);
+  }
+}
@@ -0,0 +1,63 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#define ARDUINOJSON_ENABLE_PREVIOUS_LINKS 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_ENABLE_PREVIOUS_LINKS == 1") {
+  DynamicJsonDocument doc(4096);
+  JsonArray arr = doc.to<JsonArray>();
+  for (int i = 0; i < 5; i++) arr.add(i);
+
+  SECTION("Remove first") {
+    arr.remove(0);
+    arr.add(5);
+    REQUIRE(doc.as<std::string>() == "[1,2,3,4,5]");
+  }
+
+  SECTION("Remove in the middle") {
+    arr.remove(2);
+    arr.remove(2);
+    REQUIRE(doc.as<std::string>() == "[0,1,4]");
+  }
+
+  SECTION("Remove last") {
+    arr.remove(4);
+    arr.remove(3);
+    arr.add(5);
+    REQUIRE(doc.as<std::string>() == "[0,1,2,5]");
+  }
+
+  SECTION("Remove all") {
+    for (int i = 0; i < 5; i++) arr.remove(4 - i);
+    REQUIRE(doc.as<std::string>() == "[]");
+
+    arr.add(6);
+    REQUIRE(doc.as<std::string>() == "[6]");
+  }
+
+  SECTION("Remove member") {
+    JsonObject obj = doc.to<JsonObject>();
+    obj["a"] = 1;
+    obj["b"] = 2;
+    obj["c"] = 3;
+
+    obj.remove("b");
+    obj.remove("c");
+    obj["d"] = 4;
+
+    REQUIRE(doc.as<std::string>() == "{\"a\":1,\"d\":4}");
+  }
+
+  SECTION("shrinkToFit()") {
+    doc.shrinkToFit();
+    arr = doc.as<JsonArray>();
+
+    arr.remove(3);
+    REQUIRE(doc.as<std::string>() == "[0,1,2,4]");
+  }
+}
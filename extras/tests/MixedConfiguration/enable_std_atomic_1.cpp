@@ -0,0 +1,58 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#define ARDUINOJSON_ENABLE_STD_ATOMIC 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string.h>
+
+typedef BasicJsonDocument<AllocatorRef<SharedSlabAllocator> >
+    SharedSlabJsonDocument;
+
+TEST_CASE("ARDUINOJSON_ENABLE_STD_ATOMIC == 1") {
+  char buffer[4096];
+  SharedSlabAllocator slab(buffer, sizeof(buffer));
+
+  SECTION("allocate() returns NULL when the block doesn't fit") {
+    REQUIRE(slab.allocate(1000) != 0);
+    REQUIRE(slab.allocate(3000) == 0);
+    REQUIRE(slab.allocate(1000) != 0);
+  }
+
+  SECTION("allocate() reuses the freed blocks of the same size") {
+    void* a = slab.allocate(100);
+    void* b = slab.allocate(100);
+    slab.deallocate(a);
+    slab.deallocate(b);
+
+    REQUIRE(slab.allocate(120) == b);
+    REQUIRE(slab.allocate(200) != a);
+    REQUIRE(slab.allocate(100) == a);
+    REQUIRE(slab.allocate(100) != a);
+  }
+
+  SECTION("reallocate() moves the content to a larger block") {
+    char* p = static_cast<char*>(slab.allocate(10));
+    strcpy(p, "hello");
+
+    char* q = static_cast<char*>(slab.reallocate(p, 500));
+
+    REQUIRE(q != p);
+    REQUIRE(strcmp(q, "hello") == 0);
+    REQUIRE(slab.reallocate(q, 400) == q);
+  }
+
+  SECTION("BasicJsonDocument") {
+    SharedSlabJsonDocument doc1(256, slab);
+    SharedSlabJsonDocument doc2(256, slab);
+
+    doc1["hello"] = "world";
+    doc2 = doc1;
+    doc1.clear();
+
+    REQUIRE(doc2["hello"] == "world");
+    REQUIRE(doc1.capacity() == 256);
+  }
+}
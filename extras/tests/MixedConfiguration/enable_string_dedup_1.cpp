@@ -0,0 +1,160 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#define ARDUINOJSON_ENABLE_STRING_DEDUP 1
+#define ARDUINOJSON_STRING_DEDUP_TABLE_SIZE 8
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_ENABLE_STRING_DEDUP == 1") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("deserializeJson() stores identical keys once") {
+    DeserializationError err =
+        deserializeJson(doc, "[{\"hello\":1},{\"hello\":2},{\"hello\":3}]");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.memoryUsage() ==
+            JSON_ARRAY_SIZE(3) + 3 * JSON_OBJECT_SIZE(1) + 6);
+    REQUIRE(doc[0]["hello"].as<int>() == 1);
+    REQUIRE(doc[2]["hello"].as<int>() == 3);
+  }
+
+  SECTION("deserializeJson() stores identical values once") {
+    DeserializationError err =
+        deserializeJson(doc, "[\"world\",\"world\",\"hello\",\"world\"]");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(4) + 12);
+    REQUIRE(doc[3] == "world");
+    REQUIRE(doc[0].as<char*>() == doc[1].as<char*>());
+  }
+
+  SECTION("deserializeJson() shares strings between keys and values") {
+    DeserializationError err =
+        deserializeJson(doc, "{\"name\":\"id\",\"id\":\"name\"}");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(2) + 8);
+    REQUIRE(doc["name"] == "id");
+    REQUIRE(doc["id"] == "name");
+  }
+
+  SECTION("deserializeJson() zero-copy") {
+    char input[] = "[\"world\",\"world\"]";
+
+    DeserializationError err = deserializeJson(doc, input);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2));
+    REQUIRE(doc[1] == "world");
+  }
+
+  SECTION("deserializeMsgPack() stores identical strings once") {
+    DeserializationError err = deserializeMsgPack(
+        doc, "\x93\x81\xA5hello\xA5world\x81\xA5hello\xA5world\xA5world");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.memoryUsage() ==
+            JSON_ARRAY_SIZE(3) + 2 * JSON_OBJECT_SIZE(1) + 12);
+    REQUIRE(doc[1]["hello"] == "world");
+    REQUIRE(doc[2] == "world");
+  }
+
+  SECTION("More strings than the table can hold") {
+    std::ostringstream input;
+    input << '[';
+    for (int i = 0; i < 20; i++) {
+      if (i > 0)
+        input << ',';
+      input << "\"s" << i << "\",\"s" << i << '"';
+    }
+    input << ']';
+
+    DeserializationError err = deserializeJson(doc, input.str());
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == input.str());
+    REQUIRE(doc.memoryUsage() < JSON_ARRAY_SIZE(40) + 40 * 4);
+  }
+}
+
+static std::string records(int n) {
+  std::ostringstream s;
+  s << '[';
+  for (int i = 0; i < n; i++) {
+    if (i > 0)
+      s << ',';
+    s << "{\"id\":" << i << ",\"type\":\"sensor\",\"unit\":\"celsius\"}";
+  }
+  s << ']';
+  return s.str();
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_STRING_DEDUP and copies") {
+  const size_t expectedUsage =
+      JSON_ARRAY_SIZE(100) + 100 * JSON_OBJECT_SIZE(3) + 28;
+  std::string json = records(100);
+  DynamicJsonDocument doc(16384);
+  deserializeJson(doc, json);
+  REQUIRE(doc.memoryUsage() == expectedUsage);
+
+  SECTION("deserializeMsgPack() stores repeated keys once") {
+    std::string msgpack;
+    serializeMsgPack(doc, msgpack);
+    DynamicJsonDocument doc2(16384);
+
+    DeserializationError err = deserializeMsgPack(doc2, msgpack);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc2.memoryUsage() == expectedUsage);
+  }
+
+  SECTION("Copy constructor") {
+    DynamicJsonDocument copy(doc);
+
+    REQUIRE(copy.as<std::string>() == json);
+    REQUIRE(copy.memoryUsage() == expectedUsage);
+  }
+
+  SECTION("garbageCollect()") {
+    REQUIRE(doc.garbageCollect() == true);
+
+    REQUIRE(doc.as<std::string>() == json);
+    REQUIRE(doc.memoryUsage() == expectedUsage);
+  }
+
+  SECTION("JsonArray::set()") {
+    DynamicJsonDocument doc2(16384);
+    JsonArray array = doc2.to<JsonArray>();
+
+    array.set(doc.as<JsonArray>());
+
+    REQUIRE(doc2.memoryUsage() == expectedUsage);
+  }
+
+  SECTION("JsonObject::set()") {
+    DynamicJsonDocument doc2(16384);
+    JsonObject obj = doc2.to<JsonObject>();
+
+    obj.set(doc[0].as<JsonObject>());
+    obj["copy"].set(doc[1]);
+
+    // each call deduplicates its own strings only
+    REQUIRE(doc2.memoryUsage() ==
+            JSON_OBJECT_SIZE(4) + JSON_OBJECT_SIZE(3) + 2 * 28);
+  }
+
+  SECTION("Strings added one by one are not deduplicated") {
+    DynamicJsonDocument doc2(1024);
+
+    doc2.add(std::string("hello"));
+    doc2.add(std::string("hello"));
+
+    REQUIRE(doc2.memoryUsage() == JSON_ARRAY_SIZE(2) + 12);
+  }
+}
@@ -0,0 +1,24 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#define ARDUINOJSON_ENABLE_STRING_DEDUP
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_STRING_DEDUP defined with no value") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("is the same as 1") {
+    REQUIRE(ARDUINOJSON_ENABLE_STRING_DEDUP == 1);
+  }
+
+  SECTION("deserializeJson() stores identical values once") {
+    DeserializationError err =
+        deserializeJson(doc, "[\"world\",\"world\",\"hello\",\"world\"]");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0].as<char*>() == doc[1].as<char*>());
+  }
+}
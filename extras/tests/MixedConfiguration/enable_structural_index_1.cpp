@@ -0,0 +1,155 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#define ARDUINOJSON_ENABLE_STRUCTURAL_INDEX 1
+#define ARDUINOJSON_STRUCTURAL_INDEX_SIZE 1  // smallest batches
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+
+static DeserializationError deserialize(JsonDocument& doc,
+                                        const std::string& input) {
+  return deserializeJson(doc, input.data(), input.size());
+}
+
+TEST_CASE("Two-stage deserializeJson()") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("Indented object") {
+    DeserializationError err = deserialize(
+        doc, "{\n  \"hello\" :  \"world\",\n\t\"answer\":\r\n 42  }  ");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["hello"] == "world");
+    REQUIRE(doc["answer"] == 42);
+  }
+
+  SECTION("Escape sequences") {
+    DeserializationError err = deserialize(
+        doc, "[\"a\\\"b\", \"c\\\\\", \"\\\\\\\"d\", \"e\\\\\\\\\", \"\\n\"]");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == "a\"b");
+    REQUIRE(doc[1] == "c\\");
+    REQUIRE(doc[2] == "\\\"d");
+    REQUIRE(doc[3] == "e\\\\");
+    REQUIRE(doc[4] == "\n");
+  }
+
+  SECTION("Spaces and quotes in strings") {
+    DeserializationError err =
+        deserialize(doc, "[ \"a b  c\", \"'/'\" , \"{ [ : , ] }\" ]");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == "a b  c");
+    REQUIRE(doc[1] == "'/'");
+    REQUIRE(doc[2] == "{ [ : , ] }");
+  }
+
+  SECTION("Single quotes") {
+    DeserializationError err =
+        deserialize(doc, "{ \"a\" : 'b\"c' , \"d\" : \"e f\" , 'g' : 1 }");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["a"] == "b\"c");
+    REQUIRE(doc["d"] == "e f");
+    REQUIRE(doc["g"] == 1);
+  }
+
+  SECTION("Unquoted keys") {
+    DeserializationError err = deserialize(doc, "{ hello : \"world\" }");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["hello"] == "world");
+  }
+
+  SECTION("Slash") {
+    DeserializationError err = deserialize(doc, "[ 1 , / 2 ]");
+
+    REQUIRE(err == DeserializationError::InvalidInput);
+  }
+
+  SECTION("NUL in string") {
+    DeserializationError err = deserialize(doc, std::string("[\"a\0b\"]", 7));
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("Unterminated string") {
+    DeserializationError err = deserialize(doc, "[ \"hello   ");
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("Trailing spaces") {
+    DeserializationError err = deserialize(doc, "[ 1 ,    ");
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("Zero-copy") {
+    char input[] = "[ \"hello\" , \"wor\\\"ld\" ]";
+
+    DeserializationError err = deserializeJson(doc, input, sizeof(input) - 1);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc[0] == "hello");
+    REQUIRE(doc[1] == "wor\"ld");
+    REQUIRE(doc[1].as<char*>() > input);
+  }
+
+  SECTION("Filter") {
+    StaticJsonDocument<64> filter;
+    filter["b"] = true;
+
+    std::string input = "{ \"a\" : \"x\\\" y\" , \"b\" : \"z\" }";
+
+    DeserializationError err =
+        deserializeJson(doc, input.data(), input.size(),
+                        DeserializationOption::Filter(filter));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "{\"b\":\"z\"}");
+  }
+}
+
+TEST_CASE("Two-stage deserializeJson() with a large document") {
+  std::ostringstream s;
+  s << '[';
+  for (int i = 0; i < 100; i++) {
+    if (i > 0)
+      s << ',';
+    s << "{\"id\":" << i << ",\"name\":\"item \\\"" << i
+      << "\\\"\",\"tags\":[";
+    for (int j = 0; j < i % 7; j++)
+      s << (j ? "," : "") << "\"t\\\\" << j << '"';
+    s << "],\"text\":\"" << std::string(size_t(i), 'x') << "\"}";
+  }
+  s << ']';
+  std::string minified = s.str();
+
+  DynamicJsonDocument doc(65536);
+
+  SECTION("Minified") {
+    DeserializationError err = deserialize(doc, minified);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == minified);
+  }
+
+  SECTION("Indented") {
+    DeserializationError err = deserialize(doc, minified);
+    REQUIRE(err == DeserializationError::Ok);
+    std::string indented;
+    serializeJsonPretty(doc, indented);
+    doc.clear();
+
+    err = deserialize(doc, indented);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == minified);
+  }
+}
@@ -0,0 +1,132 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#define ARDUINOJSON_STORE_STRING_LENGTH 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_STORE_STRING_LENGTH == 1") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("JSON_STRING_SIZE() includes the header") {
+    deserializeJson(doc, "{\"hello\":\"world\"}");
+
+    REQUIRE(doc.memoryUsage() ==
+            JSON_OBJECT_SIZE(1) + 2 * JSON_STRING_SIZE(6));
+    REQUIRE(doc.as<JsonObject>().memoryUsage() == doc.memoryUsage());
+  }
+
+  SECTION("measureJsonCapacity()") {
+    const char* input = "{\"hello\":[\"world\",\"a\\nb\"]}";
+
+    deserializeJson(doc, input);
+
+    REQUIRE(measureJsonCapacity(input) == doc.memoryUsage());
+  }
+
+  SECTION("serializeJson()") {
+    const char* input = "{\"a\\tb\":\"c\\\"d\",\"ef\":[\"\",\"\\\\\"]}";
+    deserializeJson(doc, input);
+
+    std::string output;
+    serializeJson(doc, output);
+
+    REQUIRE(output == input);
+  }
+
+  SECTION("serializeMsgPack()") {
+    doc["hello"] = std::string("world");
+
+    std::string output;
+    serializeMsgPack(doc, output);
+
+    REQUIRE(output == "\x81\xA5hello\xA5world");
+  }
+
+  SECTION("A string longer than the header can hold") {
+    std::string big(70000, 'x');
+    DynamicJsonDocument bigDoc(3 * big.size());
+    bigDoc[big] = big;
+
+    REQUIRE(bigDoc[big] == big);
+    REQUIRE(bigDoc.memoryUsage() ==
+            JSON_OBJECT_SIZE(1) + 2 * JSON_STRING_SIZE(big.size() + 1));
+    REQUIRE(measureJson(bigDoc) == 2 * big.size() + 7);
+  }
+
+  SECTION("Lookup") {
+    doc[std::string("hello")] = 1;
+    doc[std::string("hell")] = 2;
+    doc[std::string("hello!")] = 3;
+
+    REQUIRE(doc["hell"] == 2);
+    REQUIRE(doc["hello"] == 1);
+    REQUIRE(doc["hello!"] == 3);
+    REQUIRE(doc["hello?"].isNull());
+  }
+
+  SECTION("Comparison") {
+    doc[0] = std::string("hello");
+    doc[1] = std::string("hello");
+    doc[2] = std::string("hell");
+
+    REQUIRE(doc[0] == doc[1]);
+    REQUIRE(doc[0] != doc[2]);
+    REQUIRE(doc[0] == "hello");
+    REQUIRE(doc[2] != "hello");
+  }
+
+  SECTION("Strings stop at the first NUL, like in the default build") {
+    deserializeMsgPack(doc, std::string("\x83\xA1" "a\xA3x\0y"
+                                        "\xA3k\0a\x01\xA3k\0b\x02",
+                                        17));
+    doc["z"] = std::string("z\0z", 3);
+
+    std::string output;
+    serializeJson(doc, output);
+
+    REQUIRE(output == "{\"a\":\"x\",\"k\":1,\"k\":2,\"z\":\"z\"}");
+    REQUIRE(doc["a"] == "x");
+    REQUIRE(doc["a"].as<std::string>().size() == 1);
+    REQUIRE(doc["k"] == 1);
+    REQUIRE(doc["z"] == "z");
+  }
+
+  SECTION("Copy") {
+    deserializeJson(doc, "{\"hello\":[\"world\"]}");
+
+    DynamicJsonDocument copy(doc);
+
+    REQUIRE(copy == doc);
+    REQUIRE(copy.memoryUsage() == doc.memoryUsage());
+  }
+
+  SECTION("Zero-copy strings are linked") {
+    char input[] = "{\"hello\":\"world\"}";
+
+    deserializeJson(doc, input);
+
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1));
+    REQUIRE(doc["hello"].as<char*>() == input + 6);
+
+    doc.shrinkToFit();
+
+    REQUIRE(doc["hello"] == "world");
+    REQUIRE(doc.as<JsonObject>().memoryUsage() == JSON_OBJECT_SIZE(1));
+  }
+
+  SECTION("Zero-copy strings stay linked in the copies") {
+    char input[] = "{\"hello\":\"world\"}";
+    deserializeJson(doc, input);
+
+    DynamicJsonDocument copy(doc);
+    doc.garbageCollect();
+
+    REQUIRE(copy["hello"].as<char*>() == input + 6);
+    REQUIRE(doc["hello"].as<char*>() == input + 6);
+    REQUIRE(copy.memoryUsage() == JSON_OBJECT_SIZE(1));
+  }
+}
@@ -64,6 +64,17 @@ TEST_CASE("deserializeMsgPack(StaticJsonDocument&)") {
                     DeserializationError::Ok);
     checkString<16>("\xDB\x00\x00\x00\x10ZZZZZZZZZZZZZZZZ",
                     DeserializationError::NoMemory);
+    checkString<16>("\xDB\xFF\xFF\xFF\xFFZZZZZZZZ",
+                    DeserializationError::NoMemory);
+  }
+
+  SECTION("bin 32") {
+    check<8>("\xC6\xFF\xFF\xFF\xFFZZZZZZZZ", DeserializationError::NoMemory);
+  }
+
+  SECTION("ext 32") {
+    check<8>("\xC9\xFF\xFF\xFF\xFF\x01ZZZZZZZ",
+             DeserializationError::NoMemory);
   }
 
   SECTION("fixarray") {
@@ -143,4 +143,99 @@ TEST_CASE("deserialize MsgPack value") {
   SECTION("str 32") {
     check<const char*>("\xdb\x00\x00\x00\x05hello", std::string("hello"));
   }
+
+  SECTION("str 8 longer than the read buffer") {
+    std::string expected;
+    for (int i = 0; i < 100; i++) expected += char('a' + i % 26);
+    std::string input = "\xd9\x64" + expected;
+
+    check<const char*>(input.c_str(), expected);
+  }
+}
+
+static void checkBinary(const char* input, size_t inputSize,
+                        const std::string& expected) {
+  DynamicJsonDocument doc(4096);
+
+  DeserializationError error = deserializeMsgPack(doc, input, inputSize);
+
+  REQUIRE(error == DeserializationError::Ok);
+  REQUIRE(doc.is<MsgPackBinary>());
+  MsgPackBinary binary = doc.as<MsgPackBinary>();
+  REQUIRE(std::string(reinterpret_cast<const char*>(binary.data()),
+                      binary.size()) == expected);
+}
+
+static void checkExtension(const char* input, size_t inputSize, int8_t type,
+                           const std::string& expected) {
+  DynamicJsonDocument doc(4096);
+
+  DeserializationError error = deserializeMsgPack(doc, input, inputSize);
+
+  REQUIRE(error == DeserializationError::Ok);
+  REQUIRE(doc.is<MsgPackExtension>());
+  MsgPackExtension extension = doc.as<MsgPackExtension>();
+  REQUIRE(extension.type() == type);
+  REQUIRE(std::string(reinterpret_cast<const char*>(extension.data()),
+                      extension.size()) == expected);
+}
+
+TEST_CASE("deserialize MsgPack bin and ext") {
+  SECTION("bin 8") {
+    checkBinary("\xc4\x00", 2, "");
+    checkBinary("\xc4\x03\x00\x01\xff", 5, std::string("\x00\x01\xff", 3));
+  }
+
+  SECTION("bin 16") {
+    checkBinary("\xc5\x00\x03\x00\x01\xff", 6,
+                std::string("\x00\x01\xff", 3));
+  }
+
+  SECTION("bin 32") {
+    checkBinary("\xc6\x00\x00\x00\x03\x00\x01\xff", 8,
+                std::string("\x00\x01\xff", 3));
+  }
+
+  SECTION("fixext 1") {
+    checkExtension("\xd4\x05\x00", 3, 5, std::string("\x00", 1));
+  }
+
+  SECTION("fixext 2") {
+    checkExtension("\xd5\x05\x00\x01", 4, 5, std::string("\x00\x01", 2));
+  }
+
+  SECTION("fixext 16") {
+    checkExtension("\xd8\x05"
+                   "0123456789abcdef",
+                   18, 5, "0123456789abcdef");
+  }
+
+  SECTION("ext 8") {
+    checkExtension("\xc7\x03\x05\x00\x01\xff", 6, 5,
+                   std::string("\x00\x01\xff", 3));
+  }
+
+  SECTION("ext 16") {
+    checkExtension("\xc8\x00\x03\x05\x00\x01\xff", 7, 5,
+                   std::string("\x00\x01\xff", 3));
+  }
+
+  SECTION("ext 32") {
+    checkExtension("\xc9\x00\x00\x00\x03\xfb\x00\x01\xff", 9, -5,
+                   std::string("\x00\x01\xff", 3));
+  }
+
+  SECTION("timestamp 32") {
+    checkExtension("\xd6\xff\x5e\xbe\x8a\x00", 6, -1,
+                   std::string("\x5e\xbe\x8a\x00", 4));
+  }
+
+  SECTION("timestamp 96") {
+    checkExtension("\xc7\x0c\xff\x00\x00\x00\x01\x00\x00\x00\x00\x5e\xbe\x8a"
+                   "\x00",
+                   15, -1,
+                   std::string("\x00\x00\x00\x01\x00\x00\x00\x00\x5e\xbe\x8a"
+                               "\x00",
+                               12));
+  }
 }
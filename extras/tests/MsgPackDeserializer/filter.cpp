@@ -0,0 +1,226 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include <sstream>
+#include <string>
+
+using namespace DeserializationOption;
+
+static void check(const std::string& input, const char* filterJson,
+                  uint8_t nestingLimit, DeserializationError expectedError,
+                  const char* expectedOutput, size_t expectedMemoryUsage) {
+  DynamicJsonDocument filter(256);
+  DynamicJsonDocument doc(256);
+  REQUIRE(deserializeJson(filter, filterJson) == DeserializationError::Ok);
+
+  DeserializationError error =
+      deserializeMsgPack(doc, input.data(), input.size(), Filter(filter),
+                         NestingLimit(nestingLimit));
+
+  CHECK(error == expectedError);
+  CHECK(doc.as<std::string>() == expectedOutput);
+  CHECK(doc.memoryUsage() == expectedMemoryUsage);
+}
+
+static std::string skipped(const std::string& value) {
+  // {"skip":value,"z":1}
+  return std::string("\x82\xA4skip", 6) + value + "\xA1z\x01";
+}
+
+TEST_CASE("deserializeMsgPack() with a Filter") {
+  const std::string helloWorld("\x81\xA5hello\xA5world", 13);
+
+  SECTION("null filter") {
+    check(helloWorld, "null", 10, DeserializationError::Ok, "null", 0);
+  }
+
+  SECTION("false filter") {
+    check(helloWorld, "false", 10, DeserializationError::Ok, "null", 0);
+  }
+
+  SECTION("true filter") {
+    check(helloWorld, "true", 10, DeserializationError::Ok,
+          "{\"hello\":\"world\"}", JSON_OBJECT_SIZE(1) + 12);
+  }
+
+  SECTION("empty object filter") {
+    check(helloWorld, "{}", 10, DeserializationError::Ok, "{}",
+          JSON_OBJECT_SIZE(0));
+  }
+
+  SECTION("input is an object, but filter wants an array") {
+    check(helloWorld, "[]", 10, DeserializationError::Ok, "null", 0);
+  }
+
+  SECTION("input is an array, but filter wants an object") {
+    check(std::string("\x92\xA5hello\xA5world", 13), "{}", 10,
+          DeserializationError::Ok, "null", 0);
+  }
+
+  SECTION("input is a value, but filter wants an object") {
+    check("\xC3", "{}", 10, DeserializationError::Ok, "null", 0);
+  }
+
+  SECTION("member filter") {
+    // {"include":42,"ignore":"skip me"}
+    check(std::string("\x82\xA7include\x2A\xA6ignore\xA7skip me", 25),
+          "{\"include\":true}", 10, DeserializationError::Ok,
+          "{\"include\":42}", JSON_OBJECT_SIZE(1) + 8);
+  }
+
+  SECTION("element filter") {
+    // [{"a":1,"b":2},{"a":3,"b":[1,2]}]
+    check(std::string("\x92\x82\xA1"
+                      "a\x01\xA1"
+                      "b\x02\x82\xA1"
+                      "a\x03\xA1"
+                      "b\x92\x01\x02",
+                      17),
+          "[{\"a\":true}]", 10, DeserializationError::Ok,
+          "[{\"a\":1},{\"a\":3}]",
+          JSON_ARRAY_SIZE(2) + 2 * JSON_OBJECT_SIZE(1) + 4);
+  }
+
+  SECTION("skips every type of value") {
+    const char* values[] = {
+        "\xC0",                                  // nil
+        "\xC2",                                  // false
+        "\xC3",                                  // true
+        "\x7F",                                  // positive fixint
+        "\xE0",                                  // negative fixint
+        "\xCC\xFF",                              // uint 8
+        "\xCD\xFF\xFF",                          // uint 16
+        "\xCE\xFF\xFF\xFF\xFF",                  // uint 32
+        "\xCF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF",  // uint 64
+        "\xD0\xFF",                              // int 8
+        "\xD1\xFF\xFF",                          // int 16
+        "\xD2\xFF\xFF\xFF\xFF",                  // int 32
+        "\xD3\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF",  // int 64
+        "\xCA\x40\x48\xF5\xC3",                  // float 32
+        "\xCB\x40\x09\x21\xCA\xC0\x83\x12\x6F",  // float 64
+        "\xA3xyz",                               // fixstr
+        "\xD9\x03xyz",                           // str 8
+        "\xDA\x00\x03xyz",                       // str 16
+        "\xDB\x00\x00\x00\x03xyz",               // str 32
+        "\xC4\x03xyz",                           // bin 8
+        "\xC5\x00\x03xyz",                       // bin 16
+        "\xC6\x00\x00\x00\x03xyz",               // bin 32
+        "\xD4\x01x",                             // fixext 1
+        "\xD5\x01xy",                            // fixext 2
+        "\xD6\x01xyzt",                          // fixext 4
+        "\xD7\x01xyztxyzt",                      // fixext 8
+        "\xD8\x01xyztxyztxyztxyzt",              // fixext 16
+        "\xC7\x03\x01xyz",                       // ext 8
+        "\xC8\x00\x03\x01xyz",                   // ext 16
+        "\xC9\x00\x00\x00\x03\x01xyz",           // ext 32
+        "\x92\x01\xA1x",                         // fixarray
+        "\xDC\x00\x02\x01\xA1x",                 // array 16
+        "\xDD\x00\x00\x00\x02\x01\xA1x",         // array 32
+        "\x81\xA1x\x92\x01\x02",                 // fixmap
+        "\xDE\x00\x01\xA1x\x01",                 // map 16
+        "\xDF\x00\x00\x00\x01\xA1x\x01",         // map 32
+    };
+    const size_t sizes[] = {1, 1, 1, 1, 1, 2, 3,  5,  9,  2, 3, 5,
+                            9, 5, 9, 4, 5, 6, 8,  5,  6,  8, 3, 4,
+                            6, 10, 18, 6, 7, 9, 4, 6, 8, 6, 6, 8};
+    REQUIRE(sizeof(values) / sizeof(values[0]) ==
+            sizeof(sizes) / sizeof(sizes[0]));
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+      CAPTURE(i);
+      check(skipped(std::string(values[i], sizes[i])), "{\"z\":true}", 10,
+            DeserializationError::Ok, "{\"z\":1}", JSON_OBJECT_SIZE(1) + 2);
+    }
+  }
+
+  SECTION("incomplete input in a skipped value") {
+    check(std::string("\x82\xA4skip\xD9\x05xyz", 11), "{\"z\":true}", 10,
+          DeserializationError::IncompleteInput, "{}", JSON_OBJECT_SIZE(0));
+  }
+
+  SECTION("skipped ext 32 with the largest length") {
+    check(skipped("\xC9\xFF\xFF\xFF\xFF\x01\x01"), "{\"z\":true}", 10,
+          DeserializationError::IncompleteInput, "{}", JSON_OBJECT_SIZE(0));
+  }
+
+  SECTION("unsupported value in a skipped value") {
+    check(skipped("\xC1"), "{\"z\":true}", 10,
+          DeserializationError::NotSupported, "{}", JSON_OBJECT_SIZE(0));
+  }
+
+  SECTION("nesting limit in a skipped value") {
+    check(skipped("\x91\x91\x90"), "{\"z\":true}", 3,
+          DeserializationError::TooDeep, "{}", JSON_OBJECT_SIZE(0));
+    check(skipped("\x91\x91\x90"), "{\"z\":true}", 4,
+          DeserializationError::Ok, "{\"z\":1}", JSON_OBJECT_SIZE(1) + 2);
+  }
+}
+
+TEST_CASE("deserializeMsgPack() overloads with a Filter") {
+  StaticJsonDocument<256> doc;
+  StaticJsonDocument<256> filter;
+  filter["hello"] = true;
+
+  SECTION("const char*, Filter") {
+    deserializeMsgPack(doc, "\x82\xA5hello\x01\xA1x\x02", Filter(filter));
+  }
+
+  SECTION("const char*, size_t, Filter") {
+    deserializeMsgPack(doc, "\x82\xA5hello\x01\xA1x\x02", 11, Filter(filter));
+  }
+
+  SECTION("const std::string&, Filter") {
+    deserializeMsgPack(doc, std::string("\x82\xA5hello\x01\xA1x\x02"),
+                       Filter(filter));
+  }
+
+  SECTION("std::istream&, Filter") {
+    std::stringstream s("\x82\xA5hello\x01\xA1x\x02");
+    deserializeMsgPack(doc, s, Filter(filter));
+  }
+
+  SECTION("const char*, Filter, NestingLimit") {
+    deserializeMsgPack(doc, "\x82\xA5hello\x01\xA1x\x02", Filter(filter),
+                       NestingLimit(5));
+  }
+
+  SECTION("const char*, size_t, Filter, NestingLimit") {
+    deserializeMsgPack(doc, "\x82\xA5hello\x01\xA1x\x02", 11, Filter(filter),
+                       NestingLimit(5));
+  }
+
+  SECTION("std::istream&, NestingLimit, Filter") {
+    std::stringstream s("\x82\xA5hello\x01\xA1x\x02");
+    deserializeMsgPack(doc, s, NestingLimit(5), Filter(filter));
+  }
+
+  SECTION("const char*, size_t, NestingLimit, Filter") {
+    deserializeMsgPack(doc, "\x82\xA5hello\x01\xA1x\x02", 11, NestingLimit(5),
+                       Filter(filter));
+  }
+
+  REQUIRE(doc.as<std::string>() == "{\"hello\":1}");
+}
+
+TEST_CASE("deserializeMsgPack() with a Filter and StringMover::reclaim()") {
+  StaticJsonDocument<200> filter;
+  filter["a"] = true;
+  filter["c"] = true;
+  char input[] = "\x83\xA1"
+                 "a\x01\xA1"
+                 "b\x02\xA1"
+                 "c\x03";
+
+  StaticJsonDocument<200> doc;
+  deserializeMsgPack(doc, input, Filter(filter));
+
+  REQUIRE(doc.as<std::string>() == "{\"a\":1,\"c\":3}");
+  CHECK(input[0] == 'a');
+  CHECK(input[1] == 0);
+  CHECK(input[2] == 'c');
+  CHECK(input[3] == 0);
+}
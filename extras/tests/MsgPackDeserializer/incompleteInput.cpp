@@ -108,4 +108,32 @@ TEST_CASE("deserializeMsgPack() returns IncompleteInput") {
   SECTION("str 32") {
     checkAllSizes("\xdb\x00\x00\x00\x05hello", 10);
   }
+
+  SECTION("bin 8") {
+    checkAllSizes("\xc4\x01X", 3);
+  }
+
+  SECTION("bin 16") {
+    checkAllSizes("\xc5\x00\x01X", 4);
+  }
+
+  SECTION("bin 32") {
+    checkAllSizes("\xc6\x00\x00\x00\x01X", 6);
+  }
+
+  SECTION("fixext 1") {
+    checkAllSizes("\xd4\x01X", 3);
+  }
+
+  SECTION("ext 8") {
+    checkAllSizes("\xc7\x01\x01X", 4);
+  }
+
+  SECTION("ext 16") {
+    checkAllSizes("\xc8\x00\x01\x01X", 5);
+  }
+
+  SECTION("ext 32") {
+    checkAllSizes("\xc9\x00\x00\x00\x01\x01X", 7);
+  }
 }
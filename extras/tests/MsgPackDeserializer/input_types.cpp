@@ -93,3 +93,107 @@ TEST_CASE("deserializeMsgPack(CustomReader)") {
   REQUIRE(doc[0] == "Hello");
   REQUIRE(doc[1] == "world");
 }
+
+TEST_CASE("deserializeMsgPack(char*)") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("should store the strings in the input") {
+    char input[] = "\x82\xA5hello\xA5world\xA1x\xD9\x03"
+                   "abc";
+
+    DeserializationError err = deserializeMsgPack(doc, input);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["hello"] == "world");
+    REQUIRE(doc["x"] == "abc");
+    REQUIRE(doc["hello"].as<char*>() == input + 6);
+  }
+
+  SECTION("should detect incomplete input") {
+    char input[] = "\x91\xA5hel";
+
+    DeserializationError err = deserializeMsgPack(doc, input, 5);
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+}
+
+TEST_CASE("deserializeMsgPack(linkedInput())") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("should link the string values to the input") {
+    const char input[] = "\x82\xA5hello\xA5world\xA1x\xD9\x03"
+                         "abc";
+
+    DeserializationError err =
+        deserializeMsgPack(doc, linkedInput(input, sizeof(input) - 1));
+
+    REQUIRE(err == DeserializationError::Ok);
+    // only the keys are in the pool
+    REQUIRE(doc.memoryUsage() ==
+            JSON_OBJECT_SIZE(2) + JSON_STRING_SIZE(6) + JSON_STRING_SIZE(2));
+    REQUIRE(doc["hello"] == "world");
+    REQUIRE(doc["hello"] != "worl");
+    REQUIRE(doc["hello"] != "worlds");
+    REQUIRE(doc["x"] == "abc");
+    REQUIRE(doc["hello"].is<const char*>());
+    REQUIRE(doc["hello"].as<std::string>() == "world");
+    REQUIRE(doc["hello"].as<const char*>() == 0);  // no terminator
+  }
+
+  SECTION("should serialize the linked strings") {
+    const uint8_t input[] = {0x92, 0xA3, 'a', 'b', 'c', 0xA2, 'd', 'e'};
+
+    DeserializationError err =
+        deserializeMsgPack(doc, linkedInput(input, sizeof(input)));
+    std::string json;
+    serializeJson(doc, json);
+    std::string msgpack;
+    serializeMsgPack(doc, msgpack);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(json == "[\"abc\",\"de\"]");
+    REQUIRE(msgpack == std::string(reinterpret_cast<const char*>(input),
+                                   sizeof(input)));
+  }
+
+  SECTION("should compare with other strings") {
+    const char input[] = "\x91\xA3"
+                         "abc";
+    DynamicJsonDocument other(4096);
+    other.add("abc");
+
+    DeserializationError err =
+        deserializeMsgPack(doc, linkedInput(input, sizeof(input) - 1));
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc == other);
+    other[0] = "ab";
+    REQUIRE(doc != other);
+  }
+
+  SECTION("should link bin and ext values to the input") {
+    const uint8_t input[] = {0x92, 0xC4, 0x02, 0x01, 0x02, 0xD4, 0x05, 0x03};
+
+    DeserializationError err =
+        deserializeMsgPack(doc, linkedInput(input, sizeof(input)));
+    std::string msgpack;
+    serializeMsgPack(doc, msgpack);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2));
+    REQUIRE(doc[0].as<MsgPackBinary>().data() == input + 3);
+    REQUIRE(doc[1].as<MsgPackExtension>().type() == 5);
+    REQUIRE(doc[1].as<MsgPackExtension>().data() == input + 7);
+    REQUIRE(msgpack == std::string(reinterpret_cast<const char*>(input),
+                                   sizeof(input)));
+  }
+
+  SECTION("should detect incomplete input") {
+    const char input[] = "\x91\xA5hel";
+
+    DeserializationError err = deserializeMsgPack(doc, linkedInput(input, 5));
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+}
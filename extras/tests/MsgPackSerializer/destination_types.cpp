@@ -45,3 +45,62 @@ TEST_CASE("serialize MsgPack to various destination types") {
     REQUIRE(expected_length == len);
   }
 }
+
+TEST_CASE("serialize MsgPack array 16 to various destination types") {
+  DynamicJsonDocument doc(4096);
+  JsonArray array = doc.createNestedArray();
+  for (int i = 0; i < 16; i++) array.add(i);
+  doc.add(true);
+  const std::string expected_result(
+      "\x92\xDC\x00\x10\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C"
+      "\x0D\x0E\x0F\xC3",
+      21);
+
+  SECTION("std::string") {
+    std::string result;
+    size_t len = serializeMsgPack(doc, result);
+
+    REQUIRE(expected_result == result);
+    REQUIRE(len == 21);
+  }
+
+  SECTION("std::string with content") {
+    std::string result = "prefix";
+    size_t len = serializeMsgPack(doc, result);
+
+    REQUIRE("prefix" + expected_result == result);
+    REQUIRE(len == 21);
+  }
+
+  SECTION("std::ostream") {
+    std::ostringstream result;
+    size_t len = serializeMsgPack(doc, result);
+
+    REQUIRE(expected_result == result.str());
+    REQUIRE(len == 21);
+  }
+
+  SECTION("char[]") {
+    char result[64];
+    size_t len = serializeMsgPack(doc, result);
+
+    REQUIRE(expected_result == std::string(result, len));
+    REQUIRE(len == 21);
+  }
+
+  SECTION("char[] too small") {
+    char result[12];
+    size_t len = serializeMsgPack(doc, result);
+
+    REQUIRE(expected_result.substr(0, 11) == std::string(result, len));
+    REQUIRE(len == 11);
+  }
+
+  SECTION("char[] too small for the size") {
+    char result[3];
+    size_t len = serializeMsgPack(doc, result);
+
+    REQUIRE(expected_result.substr(0, 2) == std::string(result, len));
+    REQUIRE(len == 2);
+  }
+}
@@ -12,3 +12,14 @@ TEST_CASE("measureMsgPack()") {
 
   REQUIRE(measureMsgPack(doc) == 13);
 }
+
+TEST_CASE("measureMsgPack() with array 16 and array 32") {
+  DynamicJsonDocument doc(JSON_ARRAY_SIZE(2) + JSON_ARRAY_SIZE(16) +
+                          JSON_ARRAY_SIZE(65536));
+  JsonArray array16 = doc.createNestedArray();
+  for (int i = 0; i < 16; i++) array16.add(i);
+  JsonArray array32 = doc.createNestedArray();
+  for (int i = 0; i < 65536; i++) array32.add(0);
+
+  REQUIRE(measureMsgPack(doc) == 1 + 3 + 16 + 5 + 65536);
+}
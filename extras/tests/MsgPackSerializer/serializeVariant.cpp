@@ -139,3 +139,61 @@ TEST_CASE("serialize MsgPack value") {
     checkVariant(serialized("\xDB\x00\x01\x00\x00", 5), "\xDB\x00\x01\x00\x00");
   }
 }
+
+TEST_CASE("serialize MsgPack bin and ext") {
+  SECTION("bin 8") {
+    checkVariant(MsgPackBinary("", 0), "\xC4\x00");
+    checkVariant(MsgPackBinary("\x00\x01\xFF", 3), "\xC4\x03\x00\x01\xFF");
+
+    std::string longest(255, '?');
+    checkVariant(MsgPackBinary(longest.data(), longest.size()),
+                 std::string("\xC4\xFF", 2) + longest);
+  }
+
+  SECTION("bin 16") {
+    std::string shortest(256, '?');
+    checkVariant(MsgPackBinary(shortest.data(), shortest.size()),
+                 std::string("\xC5\x01\x00", 3) + shortest);
+  }
+
+  SECTION("bin 32") {
+    DynamicJsonDocument doc(70000);
+    std::string shortest(65536, '?');
+    doc.set(MsgPackBinary(shortest.data(), shortest.size()));
+    std::string actual;
+    serializeMsgPack(doc, actual);
+
+    REQUIRE(actual == std::string("\xC6\x00\x01\x00\x00", 5) + shortest);
+  }
+
+  SECTION("fixext") {
+    checkVariant(MsgPackExtension(5, "A", 1), "\xD4\x05" "A");
+    checkVariant(MsgPackExtension(5, "AB", 2), "\xD5\x05" "AB");
+    checkVariant(MsgPackExtension(5, "ABCD", 4), "\xD6\x05" "ABCD");
+    checkVariant(MsgPackExtension(-1, "ABCDEFGH", 8), "\xD7\xFF" "ABCDEFGH");
+    checkVariant(MsgPackExtension(5, "0123456789ABCDEF", 16),
+                 "\xD8\x05" "0123456789ABCDEF");
+  }
+
+  SECTION("ext 8") {
+    checkVariant(MsgPackExtension(5, "", 0), "\xC7\x00\x05");
+    checkVariant(MsgPackExtension(5, "ABC", 3), "\xC7\x03\x05" "ABC");
+  }
+
+  SECTION("ext 16") {
+    std::string shortest(256, '?');
+    checkVariant(MsgPackExtension(5, shortest.data(), shortest.size()),
+                 std::string("\xC8\x01\x00\x05", 4) + shortest);
+  }
+
+  SECTION("ext 32") {
+    DynamicJsonDocument doc(70000);
+    std::string shortest(65536, '?');
+    doc.set(MsgPackExtension(5, shortest.data(), shortest.size()));
+    std::string actual;
+    serializeMsgPack(doc, actual);
+
+    REQUIRE(actual ==
+            std::string("\xC9\x00\x01\x00\x00\x05", 6) + shortest);
+  }
+}
@@ -18,6 +18,15 @@ void check(const char* input, std::string expected) {
   REQUIRE(writer.bytesWritten() == expected.size());
 }
 
+void checkSized(const char* input, std::string expected) {
+  char output[1024];
+  StaticStringWriter sb(output, sizeof(output));
+  TextFormatter<StaticStringWriter> writer(sb);
+  writer.writeString(input, strlen(input));
+  REQUIRE(expected == output);
+  REQUIRE(writer.bytesWritten() == expected.size());
+}
+
 TEST_CASE("TextFormatter::writeString()") {
   SECTION("EmptyString") {
     check("", "\"\"");
@@ -55,3 +64,19 @@ TEST_CASE("TextFormatter::writeString()") {
     check("\t", "\"\\t\"");
   }
 }
+
+TEST_CASE("TextFormatter::writeString(const char*, size_t)") {
+  checkSized("", "\"\"");
+  checkSized("hello", "\"hello\"");
+  checkSized("\"", "\"\\\"\"");
+  checkSized("a\tb\nc", "\"a\\tb\\nc\"");
+  checkSized("\\\\", "\"\\\\\\\\\"");
+
+  SECTION("Stops after n chars") {
+    char output[16];
+    StaticStringWriter sb(output, sizeof(output));
+    TextFormatter<StaticStringWriter> writer(sb);
+    writer.writeString("hello", 4);
+    REQUIRE(std::string("\"hell\"") == output);
+  }
+}
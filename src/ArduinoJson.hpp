@@ -19,7 +19,11 @@
 #include "ArduinoJson/Variant/VariantRef.hpp"
 
 #include "ArduinoJson/Document/DynamicJsonDocument.hpp"
+#include "ArduinoJson/Document/JsonDocumentPool.hpp"
 #include "ArduinoJson/Document/StaticJsonDocument.hpp"
+#include "ArduinoJson/Memory/AllocatorRef.hpp"
+#include "ArduinoJson/Memory/MonotonicArena.hpp"
+#include "ArduinoJson/Memory/SlabAllocator.hpp"
 
 #include "ArduinoJson/Array/ArrayImpl.hpp"
 #include "ArduinoJson/Array/ElementProxy.hpp"
@@ -52,22 +56,35 @@ typedef ARDUINOJSON_NAMESPACE::String JsonString;
 typedef ARDUINOJSON_NAMESPACE::UInt JsonUInt;
 typedef ARDUINOJSON_NAMESPACE::VariantConstRef JsonVariantConst;
 typedef ARDUINOJSON_NAMESPACE::VariantRef JsonVariant;
+using ARDUINOJSON_NAMESPACE::AllocatorRef;
 using ARDUINOJSON_NAMESPACE::BasicJsonDocument;
+using ARDUINOJSON_NAMESPACE::BasicJsonDocumentPool;
 using ARDUINOJSON_NAMESPACE::copyArray;
 using ARDUINOJSON_NAMESPACE::DeserializationError;
 using ARDUINOJSON_NAMESPACE::deserializeJson;
 using ARDUINOJSON_NAMESPACE::deserializeMsgPack;
 using ARDUINOJSON_NAMESPACE::DynamicJsonDocument;
 using ARDUINOJSON_NAMESPACE::JsonDocument;
+using ARDUINOJSON_NAMESPACE::JsonDocumentPool;
+using ARDUINOJSON_NAMESPACE::linkedInput;
 using ARDUINOJSON_NAMESPACE::measureJson;
+using ARDUINOJSON_NAMESPACE::measureJsonCapacity;
+using ARDUINOJSON_NAMESPACE::MonotonicArena;
+using ARDUINOJSON_NAMESPACE::MsgPackBinary;
+using ARDUINOJSON_NAMESPACE::MsgPackExtension;
 using ARDUINOJSON_NAMESPACE::serialized;
 using ARDUINOJSON_NAMESPACE::serializeJson;
 using ARDUINOJSON_NAMESPACE::serializeJsonPretty;
 using ARDUINOJSON_NAMESPACE::serializeMsgPack;
+#if ARDUINOJSON_ENABLE_STD_ATOMIC
+using ARDUINOJSON_NAMESPACE::SharedSlabAllocator;
+#endif
+using ARDUINOJSON_NAMESPACE::SlabAllocator;
 using ARDUINOJSON_NAMESPACE::StaticJsonDocument;
 
 namespace DeserializationOption {
 using ARDUINOJSON_NAMESPACE::Filter;
 using ARDUINOJSON_NAMESPACE::NestingLimit;
+using ARDUINOJSON_NAMESPACE::UniqueKeys;
 }  // namespace DeserializationOption
 }  // namespace ArduinoJson
@@ -130,6 +130,7 @@ class ArrayRef : public ArrayRefBase<CollectionData>,
   FORCE_INLINE bool set(ArrayConstRef src) const {
     if (!_data || !src._data)
       return false;
+    StringDedupScope dedup(*_pool);
     return _data->copyFrom(*src._data, _pool);
   }
 
@@ -151,14 +152,14 @@ class ArrayRef : public ArrayRefBase<CollectionData>,
   FORCE_INLINE void remove(iterator it) const {
     if (!_data)
       return;
-    _data->removeSlot(it.internal());
+    _data->removeSlot(it.internal(), _pool);
   }
 
   // Removes element at specified index.
   FORCE_INLINE void remove(size_t index) const {
     if (!_data)
       return;
-    _data->removeElement(index);
+    _data->removeElement(index, _pool);
   }
 
  private:
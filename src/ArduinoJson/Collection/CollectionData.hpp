@@ -12,12 +12,23 @@
 namespace ARDUINOJSON_NAMESPACE {
 
 class MemoryPool;
+class ObjectIndex;
 class VariantData;
 class VariantSlot;
 
 class CollectionData {
   VariantSlot *_head;
   VariantSlot *_tail;
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  ObjectIndex *_index;
+#endif
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  size_t _size;
+#endif
+#if ARDUINOJSON_ENABLE_DENSE_ARRAYS
+  // true if the slots are adjacent, in reverse order (see addSlot())
+  bool _dense;
+#endif
 
  public:
   // Must be a POD!
@@ -34,7 +45,7 @@ class CollectionData {
 
   VariantData *getOrAddElement(size_t index, MemoryPool *pool);
 
-  void removeElement(size_t index);
+  void removeElement(size_t index, MemoryPool *pool);
 
   bool equalsArray(const CollectionData &other) const;
 
@@ -50,8 +61,8 @@ class CollectionData {
   VariantData *getOrAddMember(TAdaptedString key, MemoryPool *pool);
 
   template <typename TAdaptedString>
-  void removeMember(TAdaptedString key) {
-    removeSlot(getSlot(key));
+  void removeMember(TAdaptedString key, MemoryPool *pool) {
+    removeSlot(getSlot(key), pool);
   }
 
   template <typename TAdaptedString>
@@ -59,6 +70,9 @@ class CollectionData {
 
   bool equalsObject(const CollectionData &other) const;
 
+  // Call this after setting the key of a slot allocated with addSlot()
+  void indexMember(VariantSlot *slot, MemoryPool *pool);
+
   // Generic
 
   void clear();
@@ -67,7 +81,10 @@ class CollectionData {
   size_t size() const;
 
   VariantSlot *addSlot(MemoryPool *);
-  void removeSlot(VariantSlot *slot);
+  void removeSlot(VariantSlot *slot, MemoryPool *pool);
+
+  // Gives the slots, and the strings they own, back to the pool
+  void release(MemoryPool *pool);
 
   bool copyFrom(const CollectionData &src, MemoryPool *pool);
 
@@ -77,6 +94,20 @@ class CollectionData {
 
   void movePointers(ptrdiff_t stringDistance, ptrdiff_t variantDistance);
 
+  // Marks the slots as live, so that MemoryPool::compactVariants() keeps them
+  void markSlots();
+
+  // Follows the slots that MemoryPool::compactVariants() moved, and unmarks
+  // them
+  void relinkSlots(const MemoryPool *pool);
+
+  template <typename TCollector>
+  void collectStrings(TCollector &collector);
+
+  // Recreates the indexes of the objects, after the garbage collector dropped
+  // them
+  void reindexMembers(MemoryPool *pool);
+
  private:
   VariantSlot *getSlot(size_t index) const;
 
@@ -84,5 +115,7 @@ class CollectionData {
   VariantSlot *getSlot(TAdaptedString key) const;
 
   VariantSlot *getPreviousSlot(VariantSlot *) const;
+
+  static void releaseSlot(VariantSlot *slot, MemoryPool *pool);
 };
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Collection/CollectionData.hpp>
+#include <ArduinoJson/Collection/ObjectIndex.hpp>
 #include <ArduinoJson/Variant/VariantData.hpp>
 
 namespace ARDUINOJSON_NAMESPACE {
@@ -14,7 +15,20 @@ inline VariantSlot* CollectionData::addSlot(MemoryPool* pool) {
   if (!slot)
     return 0;
 
+  slot->clear();
+#if ARDUINOJSON_ENABLE_PREVIOUS_LINKS
+  slot->setPrev(_tail);
+#endif
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  _size++;
+#endif
+
   if (_tail) {
+#if ARDUINOJSON_ENABLE_DENSE_ARRAYS
+    // The pool allocates the slots from right to left, so the slots of an
+    // array are adjacent, unless other slots were allocated in between.
+    _dense = _dense && slot == _tail - 1;
+#endif
     _tail->setNextNotNull(slot);
     _tail = slot;
   } else {
@@ -22,7 +36,6 @@ inline VariantSlot* CollectionData::addSlot(MemoryPool* pool) {
     _tail = slot;
   }
 
-  slot->clear();
   return slot;
 }
 
@@ -35,15 +48,55 @@ inline VariantData* CollectionData::addMember(TAdaptedString key,
                                               MemoryPool* pool) {
   VariantSlot* slot = addSlot(pool);
   if (!slotSetKey(slot, key, pool)) {
-    removeSlot(slot);
+    removeSlot(slot, pool);
     return 0;
   }
+  indexMember(slot, pool);
   return slot->data();
 }
 
+inline void CollectionData::indexMember(VariantSlot* slot, MemoryPool* pool) {
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  if (_index && !_index->canAdd()) {
+    ObjectIndex* bigger = ObjectIndex::create(2 * _index->size(), pool);
+    if (bigger) {
+      bigger->addAll(*_index);
+      _index = bigger;
+    } else if (!_index->hasRoom()) {
+      _index = 0;  // out of memory: fall back to the linear search
+    }
+  }
+
+  if (_index) {
+    _index->add(slot);
+    return;
+  }
+
+  size_t n = size();
+  if (n < ARDUINOJSON_OBJECT_INDEX_THRESHOLD)
+    return;
+  _index = ObjectIndex::create(n, pool);
+  if (!_index)
+    return;
+  for (VariantSlot* s = _head; s; s = s->next()) _index->add(s);
+#else
+  (void)slot;
+  (void)pool;
+#endif
+}
+
 inline void CollectionData::clear() {
   _head = 0;
   _tail = 0;
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  _index = 0;
+#endif
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  _size = 0;
+#endif
+#if ARDUINOJSON_ENABLE_DENSE_ARRAYS
+  _dense = true;
+#endif
 }
 
 template <typename TAdaptedString>
@@ -101,20 +154,48 @@ inline bool CollectionData::equalsArray(const CollectionData& other) const {
 
 template <typename TAdaptedString>
 inline VariantSlot* CollectionData::getSlot(TAdaptedString key) const {
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  if (_index)
+    return _index->find(key);
+#endif
   VariantSlot* slot = _head;
+#if ARDUINOJSON_STORE_STRING_LENGTH
+  // compare the length of the owned keys first
+  size_t length = key.size();
+  while (slot) {
+    if ((!slot->ownsKey() || storedLength(slot->key()) == length) &&
+        key.equals(slot->key()))
+      break;
+    slot = slot->next();
+  }
+#else
   while (slot) {
     if (key.equals(slot->key()))
       break;
     slot = slot->next();
   }
+#endif
   return slot;
 }
 
 inline VariantSlot* CollectionData::getSlot(size_t index) const {
+  if (!_head)
+    return 0;
+#if ARDUINOJSON_ENABLE_DENSE_ARRAYS
+  if (_dense)
+    return index <= size_t(_head - _tail) ? _head - index : 0;
+#endif
   return _head->next(index);
 }
 
 inline VariantSlot* CollectionData::getPreviousSlot(VariantSlot* target) const {
+#if ARDUINOJSON_ENABLE_PREVIOUS_LINKS
+  return target->prev();
+#else
+#if ARDUINOJSON_ENABLE_DENSE_ARRAYS
+  if (_dense)
+    return target == _head ? 0 : target + 1;
+#endif
   VariantSlot* current = _head;
   while (current) {
     VariantSlot* next = current->next();
@@ -123,6 +204,7 @@ inline VariantSlot* CollectionData::getPreviousSlot(VariantSlot* target) const {
     current = next;
   }
   return 0;
+#endif
 }
 
 template <typename TAdaptedString>
@@ -153,6 +235,13 @@ inline VariantData* CollectionData::getElement(size_t index) const {
 
 inline VariantData* CollectionData::getOrAddElement(size_t index,
                                                     MemoryPool* pool) {
+#if ARDUINOJSON_ENABLE_DENSE_ARRAYS
+  if (_dense) {
+    VariantSlot* slot = getSlot(index);
+    if (slot)
+      return slot->data();
+  }
+#endif
   VariantSlot* slot = _head;
   while (slot && index > 0) {
     slot = slot->next();
@@ -167,21 +256,60 @@ inline VariantData* CollectionData::getOrAddElement(size_t index,
   return slotData(slot);
 }
 
-inline void CollectionData::removeSlot(VariantSlot* slot) {
+inline void CollectionData::removeSlot(VariantSlot* slot, MemoryPool* pool) {
   if (!slot)
     return;
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  if (_index && slot->key())
+    _index->remove(slot);
+#endif
   VariantSlot* prev = getPreviousSlot(slot);
   VariantSlot* next = slot->next();
   if (prev)
     prev->setNext(next);
   else
     _head = next;
-  if (!next)
+  if (next) {
+#if ARDUINOJSON_ENABLE_PREVIOUS_LINKS
+    next->setPrev(prev);
+#endif
+  } else {
     _tail = prev;
+  }
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  _size--;
+#endif
+#if ARDUINOJSON_ENABLE_DENSE_ARRAYS
+  // removing a slot in the middle leaves a gap
+  if (prev && next)
+    _dense = false;
+#endif
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  releaseSlot(slot, pool);
+#else
+  (void)pool;
+#endif
+}
+
+inline void CollectionData::removeElement(size_t index, MemoryPool* pool) {
+  removeSlot(getSlot(index), pool);
 }
 
-inline void CollectionData::removeElement(size_t index) {
-  removeSlot(getSlot(index));
+inline void CollectionData::release(MemoryPool* pool) {
+  VariantSlot* slot = _head;
+  while (slot) {
+    VariantSlot* next = slot->next();
+    releaseSlot(slot, pool);
+    slot = next;
+  }
+}
+
+inline void CollectionData::releaseSlot(VariantSlot* slot, MemoryPool* pool) {
+  // the value was stored after the key
+  slot->data()->release(pool);
+  if (slot->ownsKey())
+    pool->freeString(slot->key(), slot->keyLength() + 1);
+  pool->freeVariant(slot);
 }
 
 inline size_t CollectionData::memoryUsage() const {
@@ -189,8 +317,12 @@ inline size_t CollectionData::memoryUsage() const {
   for (VariantSlot* s = _head; s; s = s->next()) {
     total += sizeof(VariantSlot) + s->data()->memoryUsage();
     if (s->ownsKey())
-      total += strlen(s->key()) + 1;
+      total += stringHeaderSize + s->keyLength() + 1;
   }
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  if (_index)
+    total += _index->memoryUsage();
+#endif
   return total;
 }
 
@@ -205,7 +337,11 @@ inline size_t CollectionData::nesting() const {
 }
 
 inline size_t CollectionData::size() const {
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  return _size;
+#else
   return slotSize(_head);
+#endif
 }
 
 template <typename T>
@@ -221,8 +357,80 @@ inline void CollectionData::movePointers(ptrdiff_t stringDistance,
                                          ptrdiff_t variantDistance) {
   movePointer(_head, variantDistance);
   movePointer(_tail, variantDistance);
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  movePointer(_index, variantDistance);
+  if (_index)
+    _index->movePointers(variantDistance);
+#endif
   for (VariantSlot* slot = _head; slot; slot = slot->next())
     slot->movePointers(stringDistance, variantDistance);
 }
 
+inline void ObjectIndex::movePointers(ptrdiff_t variantDistance) {
+  VariantSlot** b = buckets();
+  for (size_t i = 0; i < _capacity; i++) movePointer(b[i], variantDistance);
+}
+
+inline void CollectionData::markSlots() {
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  // the variants will move; reindexMembers() makes a new index
+  _index = 0;
+#endif
+  for (VariantSlot* slot = _head; slot; slot = slot->next()) {
+    // the mark hides the type, so we visit the children first
+    slot->data()->markSlots();
+    slot->mark();
+  }
+}
+
+inline void CollectionData::relinkSlots(const MemoryPool* pool) {
+  _head = pool->forwardVariant(_head);
+  _tail = pool->forwardVariant(_tail);
+#if ARDUINOJSON_ENABLE_DENSE_ARRAYS
+  _dense = true;
+#endif
+#if ARDUINOJSON_ENABLE_PREVIOUS_LINKS || ARDUINOJSON_ENABLE_DENSE_ARRAYS
+  VariantSlot* prev = 0;
+#endif
+  for (VariantSlot* slot = _head; slot; slot = slot->next()) {
+    slot->unmark();
+    slot->setNext(pool->forwardVariant(slot->next()));
+#if ARDUINOJSON_ENABLE_PREVIOUS_LINKS
+    slot->setPrev(prev);
+#endif
+#if ARDUINOJSON_ENABLE_DENSE_ARRAYS
+    // the slots may be adjacent now, or not anymore
+    if (prev)
+      _dense = _dense && slot == prev - 1;
+#endif
+    slot->data()->relinkSlots(pool);
+#if ARDUINOJSON_ENABLE_PREVIOUS_LINKS || ARDUINOJSON_ENABLE_DENSE_ARRAYS
+    prev = slot;
+#endif
+  }
+}
+
+template <typename TCollector>
+inline void CollectionData::collectStrings(TCollector& collector) {
+  for (VariantSlot* slot = _head; slot; slot = slot->next()) {
+    slot->collectKey(collector);
+    slot->data()->collectStrings(collector);
+  }
+}
+
+inline void CollectionData::reindexMembers(MemoryPool* pool) {
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  // the members of an object have keys, the elements of an array don't
+  if (!_index && _head && _head->key()) {
+    size_t n = size();
+    if (n >= ARDUINOJSON_OBJECT_INDEX_THRESHOLD)
+      _index = ObjectIndex::create(n, pool);
+    if (_index)
+      for (VariantSlot* s = _head; s; s = s->next()) _index->add(s);
+  }
+#endif
+  for (VariantSlot* slot = _head; slot; slot = slot->next())
+    slot->data()->reindexMembers(pool);
+}
+
 }  // namespace ARDUINOJSON_NAMESPACE
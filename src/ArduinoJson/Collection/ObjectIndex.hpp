@@ -0,0 +1,160 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/MemoryPool.hpp>
+#include <ArduinoJson/Strings/SizedRamStringAdapter.hpp>
+#include <ArduinoJson/Strings/hashString.hpp>
+#include <ArduinoJson/Variant/VariantSlot.hpp>
+
+#include <string.h>  // memset
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Hash table of the members of an object (see ARDUINOJSON_ENABLE_OBJECT_INDEX)
+//
+// It uses open addressing with linear probing: the buckets are the pointers
+// to the slots, stored right after this header. Like the slots, the table is
+// allocated on the right side of the MemoryPool, so they move together.
+class ObjectIndex {
+ public:
+  // Allocates a table for the specified number of members
+  static ObjectIndex* create(size_t size, MemoryPool* pool) {
+    size_t capacity = capacityFor(size);
+    ObjectIndex* index =
+        reinterpret_cast<ObjectIndex*>(pool->allocRight(bytesFor(capacity)));
+    if (!index)
+      return 0;
+    index->_capacity = capacity;
+    index->_size = 0;
+    memset(index->buckets(), 0, capacity * sizeof(VariantSlot*));
+    return index;
+  }
+
+  template <typename TAdaptedString>
+  VariantSlot* find(const TAdaptedString& key) const {
+    const VariantSlot* const* b = buckets();
+    for (size_t i = keyBucket(key);; i = nextBucket(i)) {
+      if (!b[i] || key.equals(b[i]->key()))
+        return const_cast<VariantSlot*>(b[i]);
+    }
+  }
+
+  // The slot must have a key
+  void add(VariantSlot* slot) {
+    ARDUINOJSON_ASSERT(_size + 1 < _capacity);
+    VariantSlot** b = buckets();
+    size_t i = slotBucket(slot);
+    while (b[i]) i = nextBucket(i);
+    b[i] = slot;
+    _size++;
+  }
+
+  void addAll(const ObjectIndex& other) {
+    const VariantSlot* const* b = other.buckets();
+    for (size_t i = 0; i < other._capacity; i++)
+      if (b[i])
+        add(const_cast<VariantSlot*>(b[i]));
+  }
+
+  void remove(VariantSlot* slot) {
+    VariantSlot** b = buckets();
+    size_t i = slotBucket(slot);
+    while (b[i] != slot) {
+      if (!b[i])
+        return;
+      i = nextBucket(i);
+    }
+
+    // Shift back the following members of the cluster, so that the probe
+    // sequences don't need tombstones
+    for (size_t j = nextBucket(i); b[j]; j = nextBucket(j)) {
+      size_t mask = _capacity - 1;
+      size_t home = slotBucket(b[j]);
+      if (((j - home) & mask) >= ((j - i) & mask)) {
+        b[i] = b[j];
+        i = j;
+      }
+    }
+    b[i] = 0;
+    _size--;
+  }
+
+  // Tells whether a member can be added without exceeding the load factor
+  bool canAdd() const {
+    return 2 * (_size + 1) <= _capacity;
+  }
+
+  // Tells whether a member can be added at all
+  bool hasRoom() const {
+    return _size + 2 <= _capacity;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+  size_t memoryUsage() const {
+    return bytesFor(_capacity);
+  }
+
+  void movePointers(ptrdiff_t variantDistance);
+
+  // Gets the bytes that CollectionData::indexMember() allocates while adding
+  // the specified number of members to an object
+  static size_t memoryUsageFor(size_t members) {
+    if (members < ARDUINOJSON_OBJECT_INDEX_THRESHOLD)
+      return 0;
+    size_t capacity = capacityFor(ARDUINOJSON_OBJECT_INDEX_THRESHOLD);
+    size_t total = bytesFor(capacity);
+    while (members > capacity / 2) {
+      capacity = capacityFor(capacity);
+      total += bytesFor(capacity);
+    }
+    return total;
+  }
+
+ private:
+  static size_t capacityFor(size_t size) {
+    // keep the load factor under 1/2, so the probe sequences stay short
+    size_t capacity = 4;
+    while (capacity < 2 * size) capacity *= 2;
+    return capacity;
+  }
+
+  // The next pointers of the slots count in slots, so the table must take a
+  // whole number of slots.
+  static size_t bytesFor(size_t capacity) {
+    size_t bytes = sizeof(ObjectIndex) + capacity * sizeof(VariantSlot*);
+    return (bytes + sizeof(VariantSlot) - 1) / sizeof(VariantSlot) *
+           sizeof(VariantSlot);
+  }
+
+  VariantSlot** buckets() {
+    return reinterpret_cast<VariantSlot**>(this + 1);
+  }
+
+  const VariantSlot* const* buckets() const {
+    return reinterpret_cast<const VariantSlot* const*>(this + 1);
+  }
+
+  template <typename TAdaptedString>
+  size_t keyBucket(const TAdaptedString& key) const {
+    return static_cast<size_t>(hashString(key)) & (_capacity - 1);
+  }
+
+  size_t slotBucket(const VariantSlot* slot) const {
+    return keyBucket(SizedRamStringAdapter(slot->key(), slot->keyLength()));
+  }
+
+  size_t nextBucket(size_t i) const {
+    return (i + 1) & (_capacity - 1);
+  }
+
+  size_t _capacity;  // a power of two
+  size_t _size;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
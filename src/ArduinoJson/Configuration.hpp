@@ -78,6 +78,11 @@
 #define ARDUINOJSON_ENABLE_STD_STREAM 0
 #endif
 
+// Embedded systems usually don't have std::atomic
+#ifndef ARDUINOJSON_ENABLE_STD_ATOMIC
+#define ARDUINOJSON_ENABLE_STD_ATOMIC 0
+#endif
+
 // Limit nesting as the stack is likely to be small
 #ifndef ARDUINOJSON_DEFAULT_NESTING_LIMIT
 #define ARDUINOJSON_DEFAULT_NESTING_LIMIT 10
@@ -109,6 +114,15 @@
 #define ARDUINOJSON_ENABLE_STD_STREAM 1
 #endif
 
+// On a computer, we can use std::atomic since C++11
+#ifndef ARDUINOJSON_ENABLE_STD_ATOMIC
+#if __cplusplus >= 201103L
+#define ARDUINOJSON_ENABLE_STD_ATOMIC 1
+#else
+#define ARDUINOJSON_ENABLE_STD_ATOMIC 0
+#endif
+#endif
+
 // On a computer, the stack is large so we can increase nesting limit
 #ifndef ARDUINOJSON_DEFAULT_NESTING_LIMIT
 #define ARDUINOJSON_DEFAULT_NESTING_LIMIT 50
@@ -172,6 +186,100 @@
 #define ARDUINOJSON_ENABLE_COMMENTS 0
 #endif
 
+// Parse contiguous inputs in two stages: index the tokens, then walk the index
+// Only applies to deserializeJson(doc, input, inputSize)
+#ifndef ARDUINOJSON_ENABLE_STRUCTURAL_INDEX
+#define ARDUINOJSON_ENABLE_STRUCTURAL_INDEX 0
+#endif
+
+// Number of tokens indexed in a batch by the two-stage parser
+// (each token takes sizeof(char*) bytes on the stack)
+#ifndef ARDUINOJSON_STRUCTURAL_INDEX_SIZE
+#define ARDUINOJSON_STRUCTURAL_INDEX_SIZE 1024
+#endif
+
+// Index the members of large objects in a hash table, to find keys in constant
+// time. The tables take 2 to 4 pointers per member in the JsonDocument, and
+// each variant takes one more pointer.
+#ifndef ARDUINOJSON_ENABLE_OBJECT_INDEX
+#define ARDUINOJSON_ENABLE_OBJECT_INDEX 0
+#endif
+
+// Number of members from which an object is indexed
+#ifndef ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+#define ARDUINOJSON_OBJECT_INDEX_THRESHOLD 16
+#endif
+
+// Access the elements of an array by index in constant time, as long as they
+// are adjacent in the JsonDocument. Each variant takes one more byte (or
+// more, with the padding).
+#ifndef ARDUINOJSON_ENABLE_DENSE_ARRAYS
+#define ARDUINOJSON_ENABLE_DENSE_ARRAYS 0
+#endif
+
+// Store the number of elements in each collection, so that size() runs in
+// constant time (each variant takes one more size_t)
+#ifndef ARDUINOJSON_CACHE_COLLECTION_SIZE
+#define ARDUINOJSON_CACHE_COLLECTION_SIZE 0
+#endif
+
+// Link each slot to the previous one, so that remove() runs in constant time
+// (each variant takes one more VariantSlotDiff, unless it fits in the padding)
+#ifndef ARDUINOJSON_ENABLE_PREVIOUS_LINKS
+#define ARDUINOJSON_ENABLE_PREVIOUS_LINKS 0
+#endif
+
+// Let DynamicJsonDocument allocate more memory chunks when the first one is
+// full, instead of failing with NoMemory (the links between the variants grow
+// to the size of a pointer)
+#ifndef ARDUINOJSON_ENABLE_GROWABLE_POOL
+#define ARDUINOJSON_ENABLE_GROWABLE_POOL 0
+#endif
+
+// Store identical strings only once when deserializing or copying, using a
+// hash table on the stack
+#ifndef ARDUINOJSON_ENABLE_STRING_DEDUP
+#define ARDUINOJSON_ENABLE_STRING_DEDUP 0
+#elif ~(~ARDUINOJSON_ENABLE_STRING_DEDUP + 0) == 0 && \
+    ~(~ARDUINOJSON_ENABLE_STRING_DEDUP + 1) == 1
+// Defined with no value, as the previous versions allowed
+#undef ARDUINOJSON_ENABLE_STRING_DEDUP
+#define ARDUINOJSON_ENABLE_STRING_DEDUP 1
+#endif
+
+// Number of buckets in the hash table of ARDUINOJSON_ENABLE_STRING_DEDUP
+// (each bucket takes sizeof(char*) bytes on the stack)
+#ifndef ARDUINOJSON_STRING_DEDUP_TABLE_SIZE
+#if ARDUINOJSON_EMBEDDED_MODE
+#define ARDUINOJSON_STRING_DEDUP_TABLE_SIZE 64
+#else
+#define ARDUINOJSON_STRING_DEDUP_TABLE_SIZE 1024
+#endif
+#endif
+
+// Store the length of the strings in the MemoryPool, on two bytes before the
+// characters, so the serializers and the comparisons don't call strlen()
+// (the strings that deserializeJson() and deserializeMsgPack() leave in a
+// writable input become linked strings, so the input must outlive the copies
+// of the document too)
+#ifndef ARDUINOJSON_STORE_STRING_LENGTH
+#define ARDUINOJSON_STORE_STRING_LENGTH 0
+#endif
+
+// Give the variants and the strings removed from a collection back to the
+// MemoryPool, which reuses them for the next allocations. Each string takes a
+// multiple of two pointers. (The strings aren't reused with
+// ARDUINOJSON_ENABLE_STRING_DEDUP, because they may be shared.)
+#ifndef ARDUINOJSON_ENABLE_FREE_LISTS
+#define ARDUINOJSON_ENABLE_FREE_LISTS 0
+#endif
+
+// Add JsonDocument::collectStep(), which collects the garbage a bit at a time.
+// The MemoryPool remembers where the collection is, in five pointers.
+#ifndef ARDUINOJSON_ENABLE_INCREMENTAL_GC
+#define ARDUINOJSON_ENABLE_INCREMENTAL_GC 0
+#endif
+
 // Support NaN in JSON
 #ifndef ARDUINOJSON_ENABLE_NAN
 #define ARDUINOJSON_ENABLE_NAN 0
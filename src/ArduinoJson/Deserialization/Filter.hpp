@@ -28,6 +28,10 @@ class Filter {
     return _variant == true;
   }
 
+  bool checkDuplicateKeys() const {
+    return true;
+  }
+
   template <typename TKey>
   Filter operator[](const TKey& key) const {
     if (_variant == true)  // "true" means "allow recursively"
@@ -57,10 +61,44 @@ struct AllowAllFilter {
     return true;
   }
 
+  bool checkDuplicateKeys() const {
+    return true;
+  }
+
   template <typename TKey>
   AllowAllFilter operator[](const TKey&) const {
     return AllowAllFilter();
   }
 };
 
+// Allows everything, like AllowAllFilter, but trusts the input to contain no
+// duplicate keys, so the deserializer doesn't search the objects for them.
+// If the input does contain duplicate keys, the objects have duplicate members.
+struct UniqueKeys {
+  bool allow() const {
+    return true;
+  }
+
+  bool allowArray() const {
+    return true;
+  }
+
+  bool allowObject() const {
+    return true;
+  }
+
+  bool allowValue() const {
+    return true;
+  }
+
+  bool checkDuplicateKeys() const {
+    return false;
+  }
+
+  template <typename TKey>
+  UniqueKeys operator[](const TKey&) const {
+    return UniqueKeys();
+  }
+};
+
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -10,6 +10,24 @@
 
 namespace ARDUINOJSON_NAMESPACE {
 
+// Skips n bytes of a reader that cannot seek, by reading them in blocks.
+// Returns the number of bytes actually skipped.
+template <typename TReader>
+inline size_t discardBytes(TReader& reader, size_t n) {
+  char buffer[64];
+  size_t skipped = 0;
+  while (skipped < n) {
+    size_t chunk = n - skipped;
+    if (chunk > sizeof(buffer))
+      chunk = sizeof(buffer);
+    size_t count = reader.readBytes(buffer, chunk);
+    skipped += count;
+    if (count < chunk)
+      break;
+  }
+  return skipped;
+}
+
 // The default reader is a simple wrapper for Readers that are not copiable
 template <typename TSource, typename Enable = void>
 struct Reader {
@@ -24,6 +42,10 @@ struct Reader {
     return _source->readBytes(buffer, length);
   }
 
+  size_t skip(size_t n) {
+    return discardBytes(*this, n);
+  }
+
  private:
   TSource* _source;
 };
@@ -36,6 +58,7 @@ struct BoundedReader {
 }  // namespace ARDUINOJSON_NAMESPACE
 
 #include <ArduinoJson/Deserialization/Readers/IteratorReader.hpp>
+#include <ArduinoJson/Deserialization/Readers/LinkedInputReader.hpp>
 #include <ArduinoJson/Deserialization/Readers/RamReader.hpp>
 #include <ArduinoJson/Deserialization/Readers/VariantReader.hpp>
 
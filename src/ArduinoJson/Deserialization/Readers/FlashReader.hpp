@@ -23,6 +23,11 @@ struct Reader<const __FlashStringHelper*, void> {
     _ptr += length;
     return length;
   }
+
+  size_t skip(size_t n) {
+    _ptr += n;
+    return n;
+  }
 };
 
 template <>
@@ -49,5 +54,13 @@ struct BoundedReader<const __FlashStringHelper*, void> {
     _ptr += length;
     return length;
   }
+
+  size_t skip(size_t n) {
+    size_t available = static_cast<size_t>(_end - _ptr);
+    if (available < n)
+      n = available;
+    _ptr += n;
+    return n;
+  }
 };
 }  // namespace ARDUINOJSON_NAMESPACE
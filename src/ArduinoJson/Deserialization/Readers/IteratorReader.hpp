@@ -11,6 +11,8 @@ class IteratorReader {
   TIterator _ptr, _end;
 
  public:
+  typedef TIterator iterator;
+
   explicit IteratorReader(TIterator begin, TIterator end)
       : _ptr(begin), _end(end) {}
 
@@ -26,6 +28,23 @@ class IteratorReader {
     while (i < length && _ptr < _end) buffer[i++] = *_ptr++;
     return i;
   }
+
+  size_t skip(size_t n) {
+    size_t available = static_cast<size_t>(_end - _ptr);
+    if (available < n)
+      n = available;
+    _ptr += n;
+    return n;
+  }
+
+  // Gives direct access to the remaining input (see Latch)
+  TIterator ptr() const {
+    return _ptr;
+  }
+
+  TIterator end() const {
+    return _end;
+  }
 };
 
 template <typename T>
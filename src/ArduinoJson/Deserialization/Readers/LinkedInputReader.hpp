@@ -0,0 +1,80 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <string.h>  // memcpy
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// A buffer in RAM that outlives the JsonDocument, so that deserializeMsgPack()
+// can link to its strings instead of copying them (see linkedInput())
+class LinkedInput {
+ public:
+  LinkedInput(const char* data, size_t size) : _data(data), _size(size) {}
+
+  const char* data() const {
+    return _data;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+ private:
+  const char* _data;
+  size_t _size;
+};
+
+// linkedInput(const char*, size_t)
+// linkedInput(const uint8_t*, size_t)
+template <typename TChar>
+inline LinkedInput linkedInput(const TChar* data, size_t size) {
+  return LinkedInput(reinterpret_cast<const char*>(data), size);
+}
+
+template <>
+struct Reader<LinkedInput, void> {
+ public:
+  explicit Reader(const LinkedInput& input)
+      : _ptr(input.data()), _end(input.data() + input.size()) {}
+
+  int read() {
+    if (_ptr < _end)
+      return static_cast<unsigned char>(*_ptr++);
+    else
+      return -1;
+  }
+
+  size_t readBytes(char* buffer, size_t length) {
+    if (length > size_t(_end - _ptr))
+      length = size_t(_end - _ptr);
+    memcpy(buffer, _ptr, length);
+    _ptr += length;
+    return length;
+  }
+
+  size_t skip(size_t n) {
+    if (n > size_t(_end - _ptr))
+      n = size_t(_end - _ptr);
+    _ptr += n;
+    return n;
+  }
+
+  // Skips the next n bytes, and returns a pointer to them, or NULL if the
+  // input is shorter
+  const char* link(size_t n) {
+    if (n > size_t(_end - _ptr))
+      return 0;
+    const char* p = _ptr;
+    _ptr += n;
+    return p;
+  }
+
+ private:
+  const char* _ptr;
+  const char* _end;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
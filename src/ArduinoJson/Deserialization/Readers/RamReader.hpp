@@ -6,6 +6,8 @@
 
 #include <ArduinoJson/Polyfills/type_traits.hpp>
 
+#include <string.h>  // memmove
+
 namespace ARDUINOJSON_NAMESPACE {
 
 template <typename T>
@@ -18,13 +20,11 @@ struct IsCharOrVoid {
 template <typename T>
 struct IsCharOrVoid<const T> : IsCharOrVoid<T> {};
 
-template <typename TSource>
-struct Reader<TSource*,
-              typename enable_if<IsCharOrVoid<TSource>::value>::type> {
-  const char* _ptr;
-
+// Reads a buffer in RAM whose size is unknown.
+// The JSON deserializer stops at the first '\0'.
+class RamReader {
  public:
-  explicit Reader(const void* ptr)
+  explicit RamReader(const void* ptr)
       : _ptr(ptr ? reinterpret_cast<const char*>(ptr) : "") {}
 
   int read() {
@@ -32,9 +32,32 @@ struct Reader<TSource*,
   }
 
   size_t readBytes(char* buffer, size_t length) {
-    for (size_t i = 0; i < length; i++) buffer[i] = *_ptr++;
+    // the buffer can overlap the input (see StringMover)
+    memmove(buffer, _ptr, length);
+    _ptr += length;
     return length;
   }
+
+  size_t skip(size_t n) {
+    _ptr += n;
+    return n;
+  }
+
+  // Gives direct access to the buffer (see Latch)
+  const char* ptr() const {
+    return _ptr;
+  }
+
+ protected:
+  const char* _ptr;
+};
+
+template <typename TSource>
+struct Reader<TSource*,
+              typename enable_if<IsCharOrVoid<TSource>::value>::type>
+    : RamReader {
+ public:
+  explicit Reader(const void* ptr) : RamReader(ptr) {}
 };
 
 template <typename TSource>
@@ -23,6 +23,27 @@ struct Reader<TSource, typename enable_if<
     return static_cast<size_t>(_stream->gcount());
   }
 
+  size_t skip(size_t n) {
+    // seek when the stream supports it (std::ifstream, std::istringstream...)
+    std::streambuf* buf = _stream->rdbuf();
+    if (buf && _stream->good()) {
+      std::streampos pos = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+      std::streampos end = buf->pubseekoff(0, std::ios::end, std::ios::in);
+      if (pos != std::streampos(-1) && end != std::streampos(-1)) {
+        std::streamoff available = end - pos;
+        if (available < 0)
+          available = 0;
+        if (static_cast<std::streamoff>(n) > available)
+          n = static_cast<size_t>(available);
+        buf->pubseekpos(pos + static_cast<std::streamoff>(n), std::ios::in);
+        return n;
+      }
+    }
+    // otherwise, let the stream discard the bytes
+    _stream->ignore(static_cast<std::streamsize>(n));
+    return static_cast<size_t>(_stream->gcount());
+  }
+
  private:
   std::istream* _stream;
 };
@@ -32,6 +32,7 @@ deserialize(JsonDocument &doc, const TString &input, NestingLimit nestingLimit,
             TFilter filter) {
   Reader<TString> reader(input);
   doc.clear();
+  StringDedupScope dedup(doc.memoryPool());
   return makeDeserializer<TDeserializer>(
              doc.memoryPool(), reader,
              makeStringStorage(doc.memoryPool(), input))
@@ -48,6 +49,7 @@ DeserializationError deserialize(JsonDocument &doc, TChar *input,
                                  TFilter filter) {
   BoundedReader<TChar *> reader(input, inputSize);
   doc.clear();
+  StringDedupScope dedup(doc.memoryPool());
   return makeDeserializer<TDeserializer>(
              doc.memoryPool(), reader,
              makeStringStorage(doc.memoryPool(), input))
@@ -62,10 +64,39 @@ DeserializationError deserialize(JsonDocument &doc, TStream &input,
                                  NestingLimit nestingLimit, TFilter filter) {
   Reader<TStream> reader(input);
   doc.clear();
+  StringDedupScope dedup(doc.memoryPool());
   return makeDeserializer<TDeserializer>(
              doc.memoryPool(), reader,
              makeStringStorage(doc.memoryPool(), input))
       .parse(doc.data(), filter, nestingLimit);
 }
 
+// measureCapacity(const std::string&, NestingLimit);
+// measureCapacity(const String&, NestingLimit);
+// measureCapacity(char*, NestingLimit);
+// measureCapacity(const char*, NestingLimit);
+// measureCapacity(const __FlashStringHelper*, NestingLimit);
+template <template <typename, typename> class TDeserializer, typename TString>
+typename enable_if<!is_array<TString>::value, size_t>::type measureCapacity(
+    const TString &input, NestingLimit nestingLimit) {
+  Reader<TString> reader(input);
+  MemoryPool pool(0, 0);  // unused
+  return makeDeserializer<TDeserializer>(pool, reader,
+                                         makeStringStorage(pool, input))
+      .measure(nestingLimit);
+}
+//
+// measureCapacity(char*, size_t, NestingLimit);
+// measureCapacity(const char*, size_t, NestingLimit);
+// measureCapacity(const __FlashStringHelper*, size_t, NestingLimit);
+template <template <typename, typename> class TDeserializer, typename TChar>
+size_t measureCapacity(TChar *input, size_t inputSize,
+                       NestingLimit nestingLimit) {
+  BoundedReader<TChar *> reader(input, inputSize);
+  MemoryPool pool(0, 0);  // unused
+  return makeDeserializer<TDeserializer>(pool, reader,
+                                         makeStringStorage(pool, input))
+      .measure(nestingLimit);
+}
+
 }  // namespace ARDUINOJSON_NAMESPACE
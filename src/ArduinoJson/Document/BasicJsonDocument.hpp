@@ -104,6 +104,14 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
   }
 
   void shrinkToFit() {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    // copy everything to a single chunk first
+    if (_pool.hasMultipleChunks()) {
+      garbageCollect();
+      if (_pool.hasMultipleChunks())
+        return;
+    }
+#endif
     ptrdiff_t bytes_reclaimed = _pool.squash();
     if (bytes_reclaimed == 0)
       return;
@@ -119,12 +127,19 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
   }
 
   bool garbageCollect() {
-    // make a temporary clone and move assign
-    BasicJsonDocument tmp(*this);
-    if (!tmp.capacity())
-      return false;
-    tmp.set(*this);
-    moveAssignFrom(tmp);
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    // the values can't move to another chunk in place, so we copy them to a
+    // single chunk
+    if (_pool.hasMultipleChunks()) {
+      BasicJsonDocument tmp(*this);
+      if (!tmp.capacity())
+        return false;
+      tmp.set(*this);
+      moveAssignFrom(tmp);
+      return true;
+    }
+#endif
+    compact();
     return true;
   }
 
@@ -133,9 +148,23 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
  private:
   MemoryPool allocPool(size_t requiredSize) {
     size_t capa = addPadding(requiredSize);
-    return MemoryPool(reinterpret_cast<char*>(this->allocate(capa)), capa);
+    MemoryPool pool(reinterpret_cast<char*>(this->allocate(capa)), capa);
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    pool.setAllocator(this, allocateChunk, deallocateChunk);
+#endif
+    return pool;
   }
 
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+  static void* allocateChunk(void* doc, size_t size) {
+    return static_cast<BasicJsonDocument*>(doc)->allocate(size);
+  }
+
+  static void deallocateChunk(void* doc, void* ptr) {
+    static_cast<BasicJsonDocument*>(doc)->deallocate(ptr);
+  }
+#endif
+
   void reallocPoolIfTooSmall(size_t requiredSize) {
     if (requiredSize <= capacity())
       return;
@@ -144,11 +173,18 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
   }
 
   void freePool() {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    _pool.freeChunks();
+#endif
     this->deallocate(memoryPool().buffer());
   }
 
   void copyAssignFrom(const JsonDocument& src) {
     reallocPoolIfTooSmall(src.capacity());
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    // the pool may come from the default constructor
+    _pool.setAllocator(this, allocateChunk, deallocateChunk);
+#endif
     set(src);
   }
 
@@ -158,6 +194,10 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
     _pool = src._pool;
     src._data.setNull();
     src._pool = MemoryPool(0, 0);
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    // the chunks now belong to this document
+    _pool.setAllocator(this, allocateChunk, deallocateChunk);
+#endif
   }
 };
 
@@ -48,6 +48,50 @@ class JsonDocument : public Visitable {
     return _pool.size();
   }
 
+  // Gets the percentage of memoryUsage() that garbageCollect() would free.
+  // It walks the document twice.
+  uint8_t fragmentation() const {
+    size_t used = memoryUsage();
+    StringCounter counter(_pool);
+    const_cast<VariantData&>(_data).collectStrings(counter);
+    size_t live = _data.memoryUsage() - counter.counted() + counter.pooled();
+    if (live >= used)
+      return 0;
+    return uint8_t(100UL * (used - live) / used);
+  }
+
+#if ARDUINOJSON_ENABLE_INCREMENTAL_GC
+  // Does a part of what garbageCollect() does: it walks the document, but
+  // moves about maxBytes, or one value or string. Returns true when the
+  // collection completes; the next call starts another one.
+  //
+  // The document remains valid between the steps, and it can change, but the
+  // objects lose their index until the collection completes. With
+  // ARDUINOJSON_ENABLE_GROWABLE_POOL, it does nothing while the pool has
+  // several chunks.
+  bool collectStep(size_t maxBytes) {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    if (_pool.hasMultipleChunks())
+      return true;
+#endif
+    StringCompaction& progress = _pool.collection();
+    if (!progress.dst) {
+      if (compactVariants(maxBytes / sizeof(VariantSlot) + 1))
+        progress = _pool.startStringCompaction();
+      return false;
+    }
+    if (_pool.compactStrings(_data, progress, maxBytes)) {
+      _pool.forwardStrings(_data, progress);
+      return false;
+    }
+    _pool.resetCollection();
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+    _data.reindexMembers(&_pool);
+#endif
+    return true;
+  }
+#endif
+
   size_t nesting() const {
     return _data.nesting();
   }
@@ -262,7 +306,7 @@ class JsonDocument : public Visitable {
   }
 
   FORCE_INLINE void remove(size_t index) {
-    _data.remove(index);
+    _data.remove(index, &_pool);
   }
   // remove(char*)
   // remove(const char*)
@@ -270,14 +314,14 @@ class JsonDocument : public Visitable {
   template <typename TChar>
   FORCE_INLINE typename enable_if<IsString<TChar*>::value>::type remove(
       TChar* key) {
-    _data.remove(adaptString(key));
+    _data.remove(adaptString(key), &_pool);
   }
   // remove(const std::string&)
   // remove(const String&)
   template <typename TString>
   FORCE_INLINE typename enable_if<IsString<TString>::value>::type remove(
       const TString& key) {
-    _data.remove(adaptString(key));
+    _data.remove(adaptString(key), &_pool);
   }
 
   FORCE_INLINE operator VariantConstRef() const {
@@ -309,6 +353,31 @@ class JsonDocument : public Visitable {
     _pool = pool;
   }
 
+  // Moves the values together, in the memory pool, so that the memory that
+  // the removed and replaced values used becomes free again.
+  // It doesn't allocate; the pool must have a single chunk.
+  void compact() {
+    compactVariants();
+    StringCompaction progress = _pool.startStringCompaction();
+    while (_pool.compactStrings(_data, progress)) {
+    }
+#if ARDUINOJSON_ENABLE_INCREMENTAL_GC
+    _pool.resetCollection();
+#endif
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+    _data.reindexMembers(&_pool);
+#endif
+  }
+
+  // Moves at most maxMoves variants, and returns true if they are compact
+  bool compactVariants(size_t maxMoves = size_t(-1)) {
+    _pool.unmarkVariants();
+    _data.markSlots();
+    bool done = _pool.compactVariants(maxMoves);
+    _data.relinkSlots(&_pool);
+    return done;
+  }
+
   VariantRef getVariant() {
     return VariantRef(&_pool, &_data);
   }
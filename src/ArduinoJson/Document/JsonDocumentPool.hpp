@@ -0,0 +1,162 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/DynamicJsonDocument.hpp>
+
+#include <stdint.h>  // uint8_t
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// The number of capacities that a BasicJsonDocumentPool can hold
+const size_t documentPoolClasses = 4;
+
+// Keeps the documents that release() gives back, so that acquire() can reuse
+// them without allocating.
+//
+// The pool is not thread-safe, but each thread can have its own. The
+// documents must return to the pool that gave them, before it's destroyed.
+template <typename TAllocator>
+class BasicJsonDocumentPool {
+ public:
+  class Document : public BasicJsonDocument<TAllocator> {
+    friend class BasicJsonDocumentPool;
+
+   private:
+    Document(size_t capa, TAllocator alloc, uint8_t sizeClass)
+        : BasicJsonDocument<TAllocator>(capa, alloc),
+          _next(0),
+          _sizeClass(sizeClass) {}
+
+    Document(const Document&);
+    Document& operator=(const Document&);
+
+    // Workaround for missing placement new
+    void* operator new(size_t, void* p) {
+      return p;
+    }
+
+    Document* _next;
+    uint8_t _sizeClass;
+  };
+
+  explicit BasicJsonDocumentPool(TAllocator alloc = TAllocator())
+      : _allocator(alloc), _classes(0) {}
+
+  ~BasicJsonDocumentPool() {
+    for (size_t i = 0; i < _classes; i++) {
+      while (_free[i]) destroy(pop(i));
+    }
+  }
+
+  // Allocates count documents of the specified capacity.
+  // Returns false if the pool already has documentPoolClasses other
+  // capacities, or if the allocator fails.
+  bool reserve(size_t capa, size_t count) {
+    capa = addPadding(capa);
+    size_t i = 0;
+    while (i < _classes && _capacities[i] != capa) i++;
+    if (i == _classes) {
+      if (_classes == documentPoolClasses)
+        return false;
+      _capacities[i] = capa;
+      _free[i] = 0;
+      _classes++;
+    }
+    while (count--) {
+      Document* doc = create(i);
+      if (!doc)
+        return false;
+      push(doc);
+    }
+    return true;
+  }
+
+  // Gets an empty document from the class with the smallest capacity that is
+  // at least capa. Allocates a new one if all the documents of the class are
+  // in use. Returns NULL if no class is large enough, or if the allocator
+  // fails.
+  Document* acquire(size_t capa) {
+    size_t best = _classes;
+    for (size_t i = 0; i < _classes; i++) {
+      if (_capacities[i] < capa)
+        continue;
+      if (best == _classes || _capacities[i] < _capacities[best])
+        best = i;
+    }
+    if (best == _classes)
+      return 0;
+    if (_free[best])
+      return pop(best);
+    return create(best);
+  }
+
+  // Clears the document and keeps it for the next acquire(), unless
+  // shrinkToFit() made it smaller than the other documents of its class
+  void release(Document* doc) {
+    if (!doc)
+      return;
+    if (doc->capacity() < _capacities[doc->_sizeClass]) {
+      destroy(doc);
+      return;
+    }
+    doc->clear();
+    push(doc);
+  }
+
+  // Gets the number of documents that acquire() can return without allocating
+  size_t available(size_t capa) const {
+    size_t n = 0;
+    for (size_t i = 0; i < _classes; i++) {
+      if (_capacities[i] != addPadding(capa))
+        continue;
+      for (const Document* doc = _free[i]; doc; doc = doc->_next) n++;
+    }
+    return n;
+  }
+
+ private:
+  BasicJsonDocumentPool(const BasicJsonDocumentPool&);
+  BasicJsonDocumentPool& operator=(const BasicJsonDocumentPool&);
+
+  Document* create(size_t sizeClass) {
+    void* p = _allocator.allocate(sizeof(Document));
+    if (!p)
+      return 0;
+    Document* doc = new (p) Document(_capacities[sizeClass], _allocator,
+                                     uint8_t(sizeClass));
+    if (doc->capacity() < _capacities[sizeClass]) {
+      destroy(doc);
+      return 0;
+    }
+    return doc;
+  }
+
+  void destroy(Document* doc) {
+    doc->~Document();
+    _allocator.deallocate(doc);
+  }
+
+  void push(Document* doc) {
+    doc->_next = _free[doc->_sizeClass];
+    _free[doc->_sizeClass] = doc;
+  }
+
+  Document* pop(size_t sizeClass) {
+    Document* doc = _free[sizeClass];
+    _free[sizeClass] = doc->_next;
+    doc->_next = 0;
+    return doc;
+  }
+
+  TAllocator _allocator;
+  size_t _classes;
+  size_t _capacities[documentPoolClasses];
+  Document* _free[documentPoolClasses];
+};
+
+typedef BasicJsonDocumentPool<DefaultAllocator> JsonDocumentPool;
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -45,8 +45,7 @@ class StaticJsonDocument : public JsonDocument {
   }
 
   void garbageCollect() {
-    StaticJsonDocument tmp(*this);
-    set(tmp);
+    compact();
   }
 
  private:
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <ArduinoJson/Collection/ObjectIndex.hpp>
 #include <ArduinoJson/Deserialization/deserialize.hpp>
 #include <ArduinoJson/Json/EscapeSequence.hpp>
 #include <ArduinoJson/Json/Latch.hpp>
@@ -49,40 +50,39 @@ class JsonDeserializer {
     return err;
   }
 
+  // Computes the capacity that parse() needs, without storing anything.
+  // If the input is invalid, returns the capacity needed to reach the error.
+  // With ARDUINOJSON_ENABLE_STRING_DEDUP, it's an upper bound.
+  size_t measure(NestingLimit nestingLimit) {
+    size_t capacity = 0;
+    measureVariant(capacity, nestingLimit);
+    return capacity;
+  }
+
  private:
   JsonDeserializer &operator=(const JsonDeserializer &);  // non-copiable
 
- #ifdef ARDUINOJSON_ENABLE_STRING_DEDUP
-  const char *findString(const char* begin, const char* str) {
- 		const char *p = begin, *q = str;
-		const size_t len = strlen(str) + 1;
-		while (p < str) {
-			size_t l = len;
-			while (l && *p++ == *q++) l--;
-			if (l == 0)
-				return p - len;
-			q = str;	
-			while (*p++);
-		}
-		return nullptr; // we reached the new string, so there is no duplicate
-}
-	/* Alternative implementation
-	const char *findString(VariantSlot *v, const char* key) {
-		VariantData& vd = reinterpret_cast<VariantData &>(v->_content);
-		if (vd.isCollection())
-			v = v->_content.asCollection.head();
-		VariantSlot* s = v;
-		for (VariantSlot* s = v; s; s = s->next()) {
-			VariantData& vd = reinterpret_cast<VariantData &>(s->_content);
-			if (!safe_strcmp(s->key(), key))
-				return s->key();
-			if (vd.isCollection())
-				return findString(s, key);
-		}
-	}
-  */
- #endif
-  
+  // Counts the chars of a string, instead of storing them
+  class StringCounter {
+   public:
+    StringCounter() : _length(0) {}
+
+    void append(char) {
+      _length++;
+    }
+
+    void append(const char *, size_t n) {
+      _length += n;
+    }
+
+    size_t length() const {
+      return _length;
+    }
+
+   private:
+    size_t _length;
+  };
+
   char current() {
     return _latch.current();
   }
@@ -271,21 +271,18 @@ class JsonDeserializer {
       TFilter memberFilter = filter[key.value];
 
       if (memberFilter.allow()) {
-        VariantData *variant = object.getMember(adaptString(key.value));
+        VariantData *variant =
+            filter.checkDuplicateKeys()
+                ? object.getMember(adaptString(key.value))
+                : 0;
         if (!variant) {
           // Allocate slot in object
           VariantSlot *slot = object.addSlot(_pool);
           if (!slot)
             return DeserializationError::NoMemory;
 
-  #ifdef ARDUINOJSON_ENABLE_STRING_DEDUP
-					const char *lookupString = findString((const char *)_pool->buffer(), key.value);
-					if (lookupString) {
-						_pool->reclaimLastString(key.value);
-						key.value = lookupString;
-					}
-  #endif
-          slot->setOwnedKey(make_not_null(key.value));
+          _stringStorage.setKey(slot, key.value);
+          object.indexMember(slot, _pool);
 
           variant = slot->data();
         }
@@ -370,6 +367,140 @@ class JsonDeserializer {
     }
   }
 
+  DeserializationError measureVariant(size_t &capacity,
+                                      NestingLimit nestingLimit) {
+    DeserializationError err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    switch (current()) {
+      case '[':
+        return measureArray(capacity, nestingLimit);
+
+      case '{':
+        return measureObject(capacity, nestingLimit);
+
+      case '\"':
+      case '\'':
+        return measureString(capacity, true);
+
+      default:
+        return skipNumericValue();
+    }
+  }
+
+  DeserializationError measureArray(size_t &capacity,
+                                    NestingLimit nestingLimit) {
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening braket
+    ARDUINOJSON_ASSERT(current() == '[');
+    move();
+
+    // Skip spaces
+    DeserializationError err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty array?
+    if (eat(']'))
+      return DeserializationError::Ok;
+
+    // Read each value
+    for (;;) {
+      // 1 - Measure value
+      capacity += sizeof(VariantSlot);
+      err = measureVariant(capacity, nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // 2 - Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // 3 - More values?
+      if (eat(']'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  // Duplicate keys are counted twice, so the result is an upper bound
+  DeserializationError measureObject(size_t &capacity,
+                                     NestingLimit nestingLimit) {
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening brace
+    ARDUINOJSON_ASSERT(current() == '{');
+    move();
+
+    // Skip spaces
+    DeserializationError err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty object?
+    if (eat('}'))
+      return DeserializationError::Ok;
+
+    // Read each key value pair
+    for (size_t members = 1;; members++) {
+      // Measure key
+      capacity += sizeof(VariantSlot);
+      err = measureString(capacity, isQuote(current()));
+      if (err)
+        return err;
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+      capacity += ObjectIndex::memoryUsageFor(members) -
+                  ObjectIndex::memoryUsageFor(members - 1);
+#endif
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // Colon
+      if (!eat(':'))
+        return DeserializationError::InvalidInput;
+
+      // Measure value
+      err = measureVariant(capacity, nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // More keys/values?
+      if (eat('}'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+    }
+  }
+
+  DeserializationError measureString(size_t &capacity, bool quoted) {
+    StringCounter counter;
+    DeserializationError err =
+        quoted ? readQuotedString(counter) : readNonQuotedString(counter);
+    if (err)
+      return err;
+    capacity += _stringStorage.poolSize(counter.length());
+    return DeserializationError::Ok;
+  }
+
   StringOrError parseKey() {
     if (isQuote(current())) {
       return parseQuotedString();
@@ -382,19 +513,24 @@ class JsonDeserializer {
     StringOrError result = parseQuotedString();
     if (result.err)
       return result.err;
-  #ifdef ARDUINOJSON_ENABLE_STRING_DEDUP
-    const char *lookupString = findString((const char *)_pool->buffer(), result.value);
-    if (lookupString) {
-      _pool->reclaimLastString(result.value);
-      result.value = lookupString;
-    }
-  #endif
-    variant.setOwnedString(make_not_null(result.value));
+    _stringStorage.setString(variant, result.value);
     return DeserializationError::Ok;
   }
 
   StringOrError parseQuotedString() {
     StringBuilder builder = _stringStorage.startString();
+    DeserializationError err = readQuotedString(builder);
+    if (err)
+      return err;
+
+    const char *result = builder.complete();
+    if (!result)
+      return DeserializationError::NoMemory;
+    return result;
+  }
+
+  template <typename TBuilder>
+  DeserializationError readQuotedString(TBuilder &builder) {
 #if ARDUINOJSON_DECODE_UNICODE
     Utf16::Codepoint codepoint;
 #endif
@@ -402,6 +538,8 @@ class JsonDeserializer {
 
     move();
     for (;;) {
+      _latch.appendStringChars(stopChar, builder);
+
       char c = current();
       move();
       if (c == stopChar)
@@ -438,15 +576,23 @@ class JsonDeserializer {
       builder.append(c);
     }
 
+    return DeserializationError::Ok;
+  }
+
+  StringOrError parseNonQuotedString() {
+    StringBuilder builder = _stringStorage.startString();
+    DeserializationError err = readNonQuotedString(builder);
+    if (err)
+      return err;
+
     const char *result = builder.complete();
     if (!result)
       return DeserializationError::NoMemory;
     return result;
   }
 
-  StringOrError parseNonQuotedString() {
-    StringBuilder builder = _stringStorage.startString();
-
+  template <typename TBuilder>
+  DeserializationError readNonQuotedString(TBuilder &builder) {
     char c = current();
     ARDUINOJSON_ASSERT(c);
 
@@ -460,10 +606,7 @@ class JsonDeserializer {
       return DeserializationError::InvalidInput;
     }
 
-    const char *result = builder.complete();
-    if (!result)
-      return DeserializationError::NoMemory;
-    return result;
+    return DeserializationError::Ok;
   }
 
   DeserializationError skipString() {
@@ -471,6 +614,8 @@ class JsonDeserializer {
 
     move();
     for (;;) {
+      _latch.skipStringChars(stopChar);
+
       char c = current();
       move();
       if (c == stopChar)
@@ -580,6 +725,8 @@ class JsonDeserializer {
 
   DeserializationError skipSpacesAndComments() {
     for (;;) {
+      _latch.skipSpaces();
+
       switch (current()) {
         // end of string
         case '\0':
@@ -666,6 +813,18 @@ DeserializationError deserializeJson(JsonDocument &doc, const TInput &input,
                                      NestingLimit nestingLimit, Filter filter) {
   return deserialize<JsonDeserializer>(doc, input, nestingLimit, filter);
 }
+template <typename TInput>
+DeserializationError deserializeJson(
+    JsonDocument &doc, const TInput &input, UniqueKeys uniqueKeys,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<JsonDeserializer>(doc, input, nestingLimit, uniqueKeys);
+}
+template <typename TInput>
+DeserializationError deserializeJson(JsonDocument &doc, const TInput &input,
+                                     NestingLimit nestingLimit,
+                                     UniqueKeys uniqueKeys) {
+  return deserialize<JsonDeserializer>(doc, input, nestingLimit, uniqueKeys);
+}
 
 // deserializeJson(JsonDocument&, const std::istream&, ...)
 template <typename TInput>
@@ -686,6 +845,18 @@ DeserializationError deserializeJson(JsonDocument &doc, TInput &input,
                                      NestingLimit nestingLimit, Filter filter) {
   return deserialize<JsonDeserializer>(doc, input, nestingLimit, filter);
 }
+template <typename TInput>
+DeserializationError deserializeJson(
+    JsonDocument &doc, TInput &input, UniqueKeys uniqueKeys,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<JsonDeserializer>(doc, input, nestingLimit, uniqueKeys);
+}
+template <typename TInput>
+DeserializationError deserializeJson(JsonDocument &doc, TInput &input,
+                                     NestingLimit nestingLimit,
+                                     UniqueKeys uniqueKeys) {
+  return deserialize<JsonDeserializer>(doc, input, nestingLimit, uniqueKeys);
+}
 
 // deserializeJson(JsonDocument&, char*, ...)
 template <typename TChar>
@@ -706,6 +877,18 @@ DeserializationError deserializeJson(JsonDocument &doc, TChar *input,
                                      NestingLimit nestingLimit, Filter filter) {
   return deserialize<JsonDeserializer>(doc, input, nestingLimit, filter);
 }
+template <typename TChar>
+DeserializationError deserializeJson(
+    JsonDocument &doc, TChar *input, UniqueKeys uniqueKeys,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<JsonDeserializer>(doc, input, nestingLimit, uniqueKeys);
+}
+template <typename TChar>
+DeserializationError deserializeJson(JsonDocument &doc, TChar *input,
+                                     NestingLimit nestingLimit,
+                                     UniqueKeys uniqueKeys) {
+  return deserialize<JsonDeserializer>(doc, input, nestingLimit, uniqueKeys);
+}
 
 // deserializeJson(JsonDocument&, char*, size_t, ...)
 template <typename TChar>
@@ -729,5 +912,44 @@ DeserializationError deserializeJson(JsonDocument &doc, TChar *input,
   return deserialize<JsonDeserializer>(doc, input, inputSize, nestingLimit,
                                        filter);
 }
+template <typename TChar>
+DeserializationError deserializeJson(
+    JsonDocument &doc, TChar *input, size_t inputSize, UniqueKeys uniqueKeys,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<JsonDeserializer>(doc, input, inputSize, nestingLimit,
+                                       uniqueKeys);
+}
+template <typename TChar>
+DeserializationError deserializeJson(JsonDocument &doc, TChar *input,
+                                     size_t inputSize,
+                                     NestingLimit nestingLimit,
+                                     UniqueKeys uniqueKeys) {
+  return deserialize<JsonDeserializer>(doc, input, inputSize, nestingLimit,
+                                       uniqueKeys);
+}
+
+// Computes the capacity that deserializeJson() needs for this input,
+// without deserializing it
+//
+// measureJsonCapacity(const std::string&, ...)
+template <typename TInput>
+size_t measureJsonCapacity(const TInput &input,
+                           NestingLimit nestingLimit = NestingLimit()) {
+  return measureCapacity<JsonDeserializer>(input, nestingLimit);
+}
+
+// measureJsonCapacity(char*, ...)
+template <typename TChar>
+size_t measureJsonCapacity(TChar *input,
+                           NestingLimit nestingLimit = NestingLimit()) {
+  return measureCapacity<JsonDeserializer>(input, nestingLimit);
+}
+
+// measureJsonCapacity(char*, size_t, ...)
+template <typename TChar>
+size_t measureJsonCapacity(TChar *input, size_t inputSize,
+                           NestingLimit nestingLimit = NestingLimit()) {
+  return measureCapacity<JsonDeserializer>(input, inputSize, nestingLimit);
+}
 
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -40,7 +40,7 @@ class JsonSerializer {
     VariantSlot *slot = object.head();
 
     while (slot != 0) {
-      _formatter.writeString(slot->key());
+      _formatter.writeString(slot->key(), slot->keyLength());
       write(':');
       slot->data()->accept(*this);
 
@@ -58,14 +58,23 @@ class JsonSerializer {
     _formatter.writeFloat(value);
   }
 
-  void visitString(const char *value) {
-    _formatter.writeString(value);
+  void visitString(const char *value, size_t n) {
+    _formatter.writeString(value, n);
   }
 
   void visitRawJson(const char *data, size_t n) {
     _formatter.writeRaw(data, n);
   }
 
+  void visitBinary(const uint8_t *data, size_t n) {
+    _formatter.writeBase64(data, n);
+  }
+
+  // JSON has no equivalent, so extensions are written as null
+  void visitExtension(int8_t, const uint8_t *, size_t) {
+    _formatter.writeRaw("null");
+  }
+
   void visitNegativeInteger(UInt value) {
     _formatter.writeNegativeInteger(value);
   }
@@ -4,11 +4,16 @@
 
 #pragma once
 
+#include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Json/Scanner.hpp>
+#include <ArduinoJson/Json/StructuralIndex.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/attributes.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
 
 namespace ARDUINOJSON_NAMESPACE {
 
-template <typename TReader>
+template <typename TReader, typename Enable = void>
 class Latch {
  public:
   Latch(TReader reader) : _reader(reader), _loaded(false) {
@@ -32,6 +37,14 @@ class Latch {
     return _current;
   }
 
+  // Bulk operations are only possible when the input is in RAM
+  template <typename TBuilder>
+  void appendStringChars(char, TBuilder&) {}
+
+  void skipSpaces() {}
+
+  void skipStringChars(char) {}
+
  private:
   void load() {
     ARDUINOJSON_ASSERT(!_ended);
@@ -52,4 +65,198 @@ class Latch {
 #endif
 };
 
+// Fast path for a NUL-terminated string in RAM.
+// The input is already in memory, so there is nothing to latch: we look at
+// the buffer directly instead of calling read() for each character.
+template <typename TReader>
+class Latch<TReader,
+            typename enable_if<is_base_of<RamReader, TReader>::value>::type> {
+ public:
+  Latch(const RamReader& reader) : _ptr(reader.ptr()) {}
+
+  FORCE_INLINE void clear() {
+    _ptr++;
+  }
+
+  int last() const {
+    return *_ptr;
+  }
+
+  FORCE_INLINE char current() const {
+    return *_ptr;
+  }
+
+  // Copies the characters of a string, until the closing quote or the next
+  // escape sequence
+  template <typename TBuilder>
+  FORCE_INLINE void appendStringChars(char stopChar, TBuilder& builder) {
+    for (size_t i = 0; i < shortStringLength; i++) {
+      if (isSpecialStringChar(*_ptr, stopChar))
+        return;
+      builder.append(*_ptr++);
+    }
+    const char* p = scanString(_ptr, stopChar);
+    builder.append(_ptr, size_t(p - _ptr));
+    _ptr = p;
+  }
+
+  FORCE_INLINE void skipStringChars(char stopChar) {
+    for (size_t i = 0; i < shortStringLength; i++) {
+      if (isSpecialStringChar(*_ptr, stopChar))
+        return;
+      _ptr++;
+    }
+    _ptr = scanString(_ptr, stopChar);
+  }
+
+  // The input is often minified, so we test the first char before calling
+  // the (heavier) scanning function
+  FORCE_INLINE void skipSpaces() {
+    if (isSpace(*_ptr))
+      _ptr = scanSpaces(_ptr);
+  }
+
+ private:
+  const char* _ptr;
+};
+
+template <typename TReader, typename Enable = void>
+struct IsIteratorReader : false_type {};
+
+template <typename TReader>
+struct IsIteratorReader<TReader,
+                        typename void_<typename TReader::iterator>::type>
+    : is_base_of<IteratorReader<typename TReader::iterator>, TReader> {};
+
+template <typename TReader, typename Enable = void>
+struct UsesStructuralIndex : false_type {};
+
+#if ARDUINOJSON_ENABLE_STRUCTURAL_INDEX
+template <typename TReader>
+struct UsesStructuralIndex<
+    TReader, typename enable_if<IsIteratorReader<TReader>::value>::type>
+    : is_same<typename TReader::iterator, const char*> {};
+#endif
+
+// Fast path for an input delimited by two iterators
+// (BoundedReader, std::string, std::vector<char>...)
+template <typename TReader>
+class Latch<TReader,
+            typename enable_if<IsIteratorReader<TReader>::value &&
+                               !UsesStructuralIndex<TReader>::value>::type> {
+  typedef typename TReader::iterator iterator;
+
+ public:
+  Latch(const TReader& reader) : _ptr(reader.ptr()), _end(reader.end()) {}
+
+  FORCE_INLINE void clear() {
+    if (_ptr < _end)
+      ++_ptr;
+  }
+
+  int last() const {
+    return current();
+  }
+
+  FORCE_INLINE char current() const {
+    return _ptr < _end ? *_ptr : 0;
+  }
+
+  // Copies the characters of a string, until the closing quote or the next
+  // escape sequence
+  template <typename TBuilder>
+  FORCE_INLINE void appendStringChars(char stopChar, TBuilder& builder) {
+    for (size_t i = 0; i < shortStringLength; i++) {
+      if (_ptr == _end || isSpecialStringChar(*_ptr, stopChar))
+        return;
+      builder.append(*_ptr);
+      ++_ptr;
+    }
+    iterator p = scanString(_ptr, _end, stopChar);
+    append(builder, _ptr, p);
+    _ptr = p;
+  }
+
+  FORCE_INLINE void skipStringChars(char stopChar) {
+    for (size_t i = 0; i < shortStringLength; i++) {
+      if (_ptr == _end || isSpecialStringChar(*_ptr, stopChar))
+        return;
+      ++_ptr;
+    }
+    _ptr = scanString(_ptr, _end, stopChar);
+  }
+
+  // The input is often minified, so we test the first char before calling
+  // the (heavier) scanning function
+  FORCE_INLINE void skipSpaces() {
+    if (isSpace(current()))
+      _ptr = scanSpaces(_ptr, _end);
+  }
+
+ private:
+  template <typename TBuilder>
+  static void append(TBuilder& builder, const char* begin, const char* end) {
+    builder.append(begin, size_t(end - begin));
+  }
+
+  template <typename TBuilder, typename TIterator>
+  static void append(TBuilder& builder, TIterator begin, TIterator end) {
+    for (; begin < end; ++begin) builder.append(*begin);
+  }
+
+  iterator _ptr, _end;
+};
+
+// Two-stage parser for a buffer in RAM (see StructuralIndex)
+template <typename TReader>
+class Latch<TReader,
+            typename enable_if<UsesStructuralIndex<TReader>::value>::type> {
+ public:
+  Latch(const TReader& reader)
+      : _ptr(reader.ptr()), _end(reader.end()), _index(_ptr, _end) {}
+
+  FORCE_INLINE void clear() {
+    if (_ptr < _end)
+      ++_ptr;
+  }
+
+  int last() const {
+    return current();
+  }
+
+  FORCE_INLINE char current() const {
+    return _ptr < _end ? *_ptr : 0;
+  }
+
+  // Copies the characters of a string, until the closing quote or the next
+  // escape sequence
+  template <typename TBuilder>
+  FORCE_INLINE void appendStringChars(char stopChar, TBuilder& builder) {
+    const char* p = findStringEnd(stopChar);
+    builder.append(_ptr, size_t(p - _ptr));
+    _ptr = p;
+  }
+
+  FORCE_INLINE void skipStringChars(char stopChar) {
+    _ptr = findStringEnd(stopChar);
+  }
+
+  FORCE_INLINE void skipSpaces() {
+    if (isSpace(current())) {
+      const char* p = _index.nextToken(_ptr);
+      _ptr = p ? p : scanSpaces(_ptr, _end);
+    }
+  }
+
+ private:
+  const char* findStringEnd(char stopChar) {
+    const char* p = _index.nextToken(_ptr);
+    return p ? p : scanString(_ptr, _end, stopChar);
+  }
+
+  const char* _ptr;
+  const char* _end;
+  StructuralIndex<ARDUINOJSON_STRUCTURAL_INDEX_SIZE> _index;
+};
+
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,133 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/attributes.hpp>
+
+#include <stddef.h>  // size_t
+#include <string.h>  // memcpy, strcspn, strspn
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// These functions look for the end of a run of "boring" characters, so the
+// deserializer can process the run at once, instead of char by char.
+// When the input is a buffer in RAM, we test a whole machine word at a time
+// (SIMD Within A Register).
+
+typedef size_t SwarWord;
+
+inline SwarWord swarBroadcast(char c) {
+  return SwarWord(-1) / 0xFF * static_cast<unsigned char>(c);
+}
+
+// Returns non-zero if one of the bytes of the word is zero
+inline SwarWord swarHasZeroByte(SwarWord x) {
+  const SwarWord ones = SwarWord(-1) / 0xFF;
+  const SwarWord highBits = ones << 7;
+  return (x - ones) & ~x & highBits;
+}
+
+// Returns a word with the high bit of each zero byte set.
+// Unlike swarHasZeroByte(), the result is exact for every byte.
+inline SwarWord swarZeroBytes(SwarWord x) {
+  const SwarWord lowBits = SwarWord(-1) / 0xFF * 0x7F;
+  return ~(((x & lowBits) + lowBits) | x | lowBits);
+}
+
+inline bool isWordAligned(const char* p) {
+  return (reinterpret_cast<size_t>(p) & (sizeof(SwarWord) - 1)) == 0;
+}
+
+// Most strings are short (keys for example). Below this length, copying them
+// char by char is faster than calling the scanning functions.
+const size_t shortStringLength = 16;
+
+inline bool isSpecialStringChar(char c, char stopChar) {
+  return c == stopChar || c == '\\' || c == '\0';
+}
+
+// Returns a pointer to the first quote, backslash, or '\0' in [p, end)
+NO_INLINE inline const char* scanString(const char* p, const char* end,
+                                        char stopChar) {
+  while (p < end && !isWordAligned(p)) {
+    if (isSpecialStringChar(*p, stopChar))
+      return p;
+    p++;
+  }
+
+  const SwarWord stopChars = swarBroadcast(stopChar);
+  const SwarWord backslashes = swarBroadcast('\\');
+  while (end - p >= static_cast<ptrdiff_t>(sizeof(SwarWord))) {
+    SwarWord w;
+    memcpy(&w, p, sizeof(w));  // compiles to a single (aligned) load
+    if (swarHasZeroByte(w) | swarHasZeroByte(w ^ stopChars) |
+        swarHasZeroByte(w ^ backslashes))
+      break;
+    p += sizeof(SwarWord);
+  }
+
+  while (p < end && !isSpecialStringChar(*p, stopChar)) p++;
+  return p;
+}
+
+// Same as above, with a NUL-terminated string.
+// We cannot read word by word because we don't know where the buffer ends.
+NO_INLINE inline const char* scanString(const char* p, char stopChar) {
+  const char stopChars[] = {stopChar, '\\', '\0'};
+  return p + strcspn(p, stopChars);
+}
+
+// Same as above, with any other iterator
+template <typename TIterator>
+inline TIterator scanString(TIterator p, TIterator end, char stopChar) {
+  while (p < end && !isSpecialStringChar(*p, stopChar)) ++p;
+  return p;
+}
+
+inline bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Returns a pointer to the first character in [p, end) that is not a space
+NO_INLINE inline const char* scanSpaces(const char* p, const char* end) {
+  while (p < end && !isWordAligned(p)) {
+    if (!isSpace(*p))
+      return p;
+    p++;
+  }
+
+  const SwarWord highBits = SwarWord(-1) / 0xFF * 0x80;
+  const SwarWord spaces = swarBroadcast(' ');
+  const SwarWord tabs = swarBroadcast('\t');
+  const SwarWord carriageReturns = swarBroadcast('\r');
+  const SwarWord lineFeeds = swarBroadcast('\n');
+  while (end - p >= static_cast<ptrdiff_t>(sizeof(SwarWord))) {
+    SwarWord w;
+    memcpy(&w, p, sizeof(w));
+    if ((swarZeroBytes(w ^ spaces) | swarZeroBytes(w ^ tabs) |
+         swarZeroBytes(w ^ carriageReturns) | swarZeroBytes(w ^ lineFeeds)) !=
+        highBits)
+      break;
+    p += sizeof(SwarWord);
+  }
+
+  while (p < end && isSpace(*p)) p++;
+  return p;
+}
+
+// Same as above, with a NUL-terminated string
+NO_INLINE inline const char* scanSpaces(const char* p) {
+  return p + strspn(p, " \t\r\n");
+}
+
+// Same as above, with any other iterator
+template <typename TIterator>
+inline TIterator scanSpaces(TIterator p, TIterator end) {
+  while (p < end && isSpace(*p)) ++p;
+  return p;
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,297 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/Scanner.hpp>
+#include <ArduinoJson/Polyfills/attributes.hpp>
+#include <ArduinoJson/Polyfills/mpl/max.hpp>
+
+#include <string.h>  // memcpy, memset
+
+#ifndef ARDUINOJSON_STRUCTURAL_INDEX_SSE2
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ARDUINOJSON_STRUCTURAL_INDEX_SSE2 1
+#else
+#define ARDUINOJSON_STRUCTURAL_INDEX_SSE2 0
+#endif
+#endif
+
+#if ARDUINOJSON_STRUCTURAL_INDEX_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Stage 1 of the two-stage parser (see ARDUINOJSON_ENABLE_STRUCTURAL_INDEX).
+//
+// Like simdjson, we process the input in blocks, and compute a bitmask for
+// each class of characters: bit i is set if the i-th char of the block
+// belongs to the class. A block is as many chars as there are bits in a word.
+// From these bitmasks, we deduce, without branching, which chars are inside
+// strings and where each token starts.
+//
+// The deserializer (stage 2) uses the index to jump over spaces and strings,
+// but still parses the tokens itself, so the result is exactly the same.
+// To work in constant memory, the index is built in batches, as the
+// deserializer consumes it.
+
+typedef SwarWord SwarMask;
+
+const size_t swarBlockSize = sizeof(SwarMask) * 8;
+
+struct BlockMasks {
+  SwarMask quotes;
+  SwarMask backslashes;
+  SwarMask spaces;
+  SwarMask nulls;
+  // single quotes and comments would need a real parser
+  SwarMask unsupported;
+};
+
+#if ARDUINOJSON_STRUCTURAL_INDEX_SSE2
+
+inline SwarMask sse2Mask(__m128i matches) {
+  return static_cast<SwarMask>(_mm_movemask_epi8(matches));
+}
+
+inline void classifyBlock(const char* chars, BlockMasks& masks) {
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i tab = _mm_set1_epi8('\t');
+  const __m128i lineFeed = _mm_set1_epi8('\n');
+  const __m128i carriageReturn = _mm_set1_epi8('\r');
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i singleQuote = _mm_set1_epi8('\'');
+  const __m128i slash = _mm_set1_epi8('/');
+
+  masks.quotes = masks.backslashes = masks.spaces = masks.nulls =
+      masks.unsupported = 0;
+  for (size_t i = 0; i < swarBlockSize; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + i));
+    masks.quotes |= sse2Mask(_mm_cmpeq_epi8(v, quote)) << i;
+    masks.backslashes |= sse2Mask(_mm_cmpeq_epi8(v, backslash)) << i;
+    masks.spaces |= sse2Mask(_mm_or_si128(
+                        _mm_or_si128(_mm_cmpeq_epi8(v, space),
+                                     _mm_cmpeq_epi8(v, tab)),
+                        _mm_or_si128(_mm_cmpeq_epi8(v, lineFeed),
+                                     _mm_cmpeq_epi8(v, carriageReturn))))
+                    << i;
+    masks.nulls |= sse2Mask(_mm_cmpeq_epi8(v, zero)) << i;
+    masks.unsupported |= sse2Mask(_mm_or_si128(_mm_cmpeq_epi8(v, singleQuote),
+                                               _mm_cmpeq_epi8(v, slash)))
+                         << i;
+  }
+}
+
+#else
+
+// Gathers the high bit of each byte of the word into the low bits of the
+// result (like _mm_movemask_epi8)
+template <typename TWord, size_t = sizeof(TWord)>
+struct SwarMoveMask {
+  static TWord apply(TWord x) {
+    TWord result = 0;
+    for (size_t i = 0; i < sizeof(TWord); i++) {
+#if ARDUINOJSON_LITTLE_ENDIAN
+      size_t shift = 8 * i + 7;
+#else
+      size_t shift = 8 * (sizeof(TWord) - 1 - i) + 7;
+#endif
+      result |= ((x >> shift) & 1) << i;
+    }
+    return result;
+  }
+};
+
+#if ARDUINOJSON_LITTLE_ENDIAN
+template <typename TWord>
+struct SwarMoveMask<TWord, 8> {
+  static TWord apply(TWord x) {
+    // the multiplication moves the bit 8*i to the bit 56+i, without collision
+    const TWord magic = (TWord(0x01020408) << 32) | TWord(0x10204080);
+    return ((x >> 7) * magic) >> 56;
+  }
+};
+#endif
+
+inline SwarWord swarMatch(SwarWord w, char c) {
+  return swarZeroBytes(w ^ swarBroadcast(c));
+}
+
+inline SwarMask swarMask(SwarWord matches) {
+  return SwarMoveMask<SwarWord>::apply(matches);
+}
+
+inline void classifyBlock(const char* chars, BlockMasks& masks) {
+  masks.quotes = masks.spaces = 0;
+  SwarWord rare = 0;
+  for (size_t i = 0; i < sizeof(SwarWord); i++) {
+    SwarWord w;
+    memcpy(&w, chars + i * sizeof(SwarWord), sizeof(w));
+    const size_t shift = i * sizeof(SwarWord);
+    masks.quotes |= swarMask(swarMatch(w, '"')) << shift;
+    masks.spaces |= swarMask(swarMatch(w, ' ') | swarMatch(w, '\t') |
+                             swarMatch(w, '\n') | swarMatch(w, '\r'))
+                    << shift;
+    rare |= swarHasZeroByte(w ^ swarBroadcast('\\')) | swarHasZeroByte(w) |
+            swarHasZeroByte(w ^ swarBroadcast('\'')) |
+            swarHasZeroByte(w ^ swarBroadcast('/'));
+  }
+
+  // Most blocks contain no backslash, no NUL, no single quote, and no slash,
+  // so we only compute their masks when needed
+  masks.backslashes = masks.nulls = masks.unsupported = 0;
+  if (!rare)
+    return;
+  for (size_t i = 0; i < sizeof(SwarWord); i++) {
+    SwarWord w;
+    memcpy(&w, chars + i * sizeof(SwarWord), sizeof(w));
+    const size_t shift = i * sizeof(SwarWord);
+    masks.backslashes |= swarMask(swarMatch(w, '\\')) << shift;
+    masks.nulls |= swarMask(swarMatch(w, '\0')) << shift;
+    masks.unsupported |= swarMask(swarMatch(w, '\'') | swarMatch(w, '/'))
+                         << shift;
+  }
+}
+
+#endif
+
+inline size_t countTrailingZeros(SwarMask x) {
+#if defined(__GNUC__)
+  if (sizeof(SwarMask) == sizeof(unsigned long))
+    return static_cast<size_t>(__builtin_ctzl(static_cast<unsigned long>(x)));
+#endif
+  size_t n = 0;
+  while (!(x & 1)) {
+    x >>= 1;
+    n++;
+  }
+  return n;
+}
+
+// Computes the XOR of all the bits up to (and including) each bit
+inline SwarMask prefixXor(SwarMask x) {
+  for (size_t shift = 1; shift < swarBlockSize; shift *= 2) x ^= x << shift;
+  return x;
+}
+
+template <size_t size>
+class StructuralIndex {
+  // a batch contains at least one block
+  static const size_t capacity = Max<size, swarBlockSize>::value;
+
+ public:
+  StructuralIndex(const char* begin, const char* end)
+      : _block(begin),
+        _end(end),
+        _count(0),
+        _cursor(0),
+        _stopped(false),
+        _inString(0),
+        _nextIsEscaped(0),
+        _afterSpace(0) {}
+
+  // Returns the position of the first token at, or after, p.
+  // Returns the end of the input if there is no more token.
+  // Returns null after a single quote or a slash, because the index can't
+  // tell what follows.
+  FORCE_INLINE const char* nextToken(const char* p) {
+    for (;;) {
+      while (_cursor < _count) {
+        if (_tokens[_cursor] >= p)
+          return _tokens[_cursor];
+        _cursor++;
+      }
+      if (_stopped)
+        return 0;
+      if (_block >= _end)
+        return _end;
+      refill();
+    }
+  }
+
+ private:
+  NO_INLINE void refill() {
+    _count = 0;
+    _cursor = 0;
+    while (_count + swarBlockSize <= capacity && _block < _end &&
+           !_stopped) {
+      if (_end - _block >= static_cast<ptrdiff_t>(swarBlockSize)) {
+        indexBlock(_block, _block);
+      } else {
+        // pad the last block with spaces, since they are not tokens
+        char tail[swarBlockSize];
+        memset(tail, ' ', swarBlockSize);
+        memcpy(tail, _block, size_t(_end - _block));
+        indexBlock(tail, _block);
+      }
+      _block += swarBlockSize;
+    }
+  }
+
+  void indexBlock(const char* chars, const char* origin) {
+    BlockMasks masks;
+    classifyBlock(chars, masks);
+
+    // Find the backslashes that start an escape sequence, and the chars they
+    // escape. A backslash escapes the next char, unless it's escaped itself,
+    // so we need to know the parity of each run of backslashes.
+    SwarMask escapes, escaped;
+    if (masks.backslashes) {
+      const SwarMask oddBits = SwarMask(-1) / 3 * 2;
+      SwarMask starts = masks.backslashes & ~_nextIsEscaped;
+      SwarMask runs = (((starts << 1) | oddBits) - starts) ^ oddBits;
+      escaped = runs ^ (masks.backslashes | _nextIsEscaped);
+      escapes = runs & masks.backslashes;
+      _nextIsEscaped = escapes >> (swarBlockSize - 1);
+    } else {
+      escaped = _nextIsEscaped;
+      escapes = 0;
+      _nextIsEscaped = 0;
+    }
+
+    // Opening quotes and the chars that follow are inside a string,
+    // closing quotes are not.
+    SwarMask quotes = masks.quotes & ~escaped;
+    SwarMask inString = prefixXor(quotes) ^ _inString;
+    _inString = SwarMask(0) - (inString >> (swarBlockSize - 1));
+
+    // Outside of strings, the deserializer only needs to know where each run
+    // of spaces ends; inside strings, where the next quote or escape is.
+    SwarMask afterSpaces =
+        ~masks.spaces & ((masks.spaces << 1) | _afterSpace);
+    _afterSpace = masks.spaces >> (swarBlockSize - 1);
+
+    SwarMask tokens =
+        (afterSpaces & ~inString) | quotes | escapes | masks.nulls;
+
+    SwarMask unsupported = masks.unsupported & ~inString;
+    if (unsupported) {
+      // keep the tokens before the first unsupported char, and stop there
+      SwarMask first = unsupported & (SwarMask(0) - unsupported);
+      tokens &= first - 1;
+      _stopped = true;
+    }
+
+    while (tokens) {
+      _tokens[_count++] = origin + countTrailingZeros(tokens);
+      tokens &= tokens - 1;
+    }
+  }
+
+  const char* _tokens[capacity];
+  const char* _block;
+  const char* _end;
+  size_t _count;
+  size_t _cursor;
+  bool _stopped;
+  SwarMask _inString;
+  SwarMask _nextIsEscaped;
+  SwarMask _afterSpace;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
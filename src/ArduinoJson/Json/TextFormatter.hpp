@@ -39,6 +39,44 @@ class TextFormatter {
     writeRaw('\"');
   }
 
+  // Writes the chars that don't need escaping in bulk
+  void writeString(const char *value, size_t n) {
+    ARDUINOJSON_ASSERT(value != NULL);
+    writeRaw('\"');
+    const char *end = value + n;
+    const char *run = value;
+    for (const char *p = value; p < end; p++) {
+      char specialChar = EscapeSequence::escapeChar(*p);
+      if (specialChar) {
+        writeRaw(run, p);
+        writeRaw('\\');
+        writeRaw(specialChar);
+        run = p + 1;
+      }
+    }
+    writeRaw(run, end);
+    writeRaw('\"');
+  }
+
+  // Writes the bytes as a base64 string (RFC 4648, with padding)
+  void writeBase64(const uint8_t *data, size_t n) {
+    writeRaw('\"');
+    char buffer[4];
+    for (size_t i = 0; i < n; i += 3) {
+      uint32_t bits = uint32_t(data[i]) << 16;
+      if (i + 1 < n)
+        bits |= uint32_t(data[i + 1]) << 8;
+      if (i + 2 < n)
+        bits |= data[i + 2];
+      buffer[0] = base64Char(uint8_t(bits >> 18));
+      buffer[1] = base64Char(uint8_t(bits >> 12));
+      buffer[2] = i + 1 < n ? base64Char(uint8_t(bits >> 6)) : '=';
+      buffer[3] = i + 2 < n ? base64Char(uint8_t(bits)) : '=';
+      writeRaw(buffer, 4);
+    }
+    writeRaw('\"');
+  }
+
   void writeChar(char c) {
     char specialChar = EscapeSequence::escapeChar(c);
     if (specialChar) {
@@ -154,5 +192,17 @@ class TextFormatter {
 
  private:
   TextFormatter &operator=(const TextFormatter &);  // cannot be assigned
+
+  // Gets the base64 digit of the 6 lowest bits
+  static char base64Char(uint8_t bits) {
+    bits &= 0x3F;
+    if (bits < 26)
+      return char('A' + bits);
+    if (bits < 52)
+      return char('a' + bits - 26);
+    if (bits < 62)
+      return char('0' + bits - 52);
+    return bits == 62 ? '+' : '/';
+  }
 };
 }  // namespace ARDUINOJSON_NAMESPACE
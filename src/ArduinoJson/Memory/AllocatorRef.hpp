@@ -0,0 +1,37 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stddef.h>  // size_t
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Lets the documents share an allocator that they can't copy, like a
+// MonotonicArena or a SlabAllocator:
+//   BasicJsonDocument<AllocatorRef<SlabAllocator> > doc(1024, slab);
+template <typename TAllocator>
+class AllocatorRef {
+ public:
+  AllocatorRef(TAllocator& allocator) : _allocator(&allocator) {}
+
+  void* allocate(size_t size) {
+    return _allocator->allocate(size);
+  }
+
+  void deallocate(void* ptr) {
+    _allocator->deallocate(ptr);
+  }
+
+  void* reallocate(void* ptr, size_t new_size) {
+    return _allocator->reallocate(ptr, new_size);
+  }
+
+ private:
+  TAllocator* _allocator;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -5,12 +5,15 @@
 #pragma once
 
 #include <ArduinoJson/Memory/Alignment.hpp>
+#include <ArduinoJson/Memory/StringCollector.hpp>
 #include <ArduinoJson/Memory/StringSlot.hpp>
+#include <ArduinoJson/Memory/StringTable.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/mpl/max.hpp>
 #include <ArduinoJson/Variant/VariantSlot.hpp>
 
-#include <string.h>  // memmove
+#include <stdint.h>  // uintptr_t
+#include <string.h>  // memcpy, memmove
 
 namespace ARDUINOJSON_NAMESPACE {
 
@@ -21,6 +24,50 @@ namespace ARDUINOJSON_NAMESPACE {
 // +-------------+--------------+--------------+
 //               ^              ^
 //             _left          _right
+//
+// With ARDUINOJSON_ENABLE_GROWABLE_POOL, the pool can allocate more chunks
+// from the allocator of the document. The pointers above refer to the current
+// chunk; each additional chunk starts with a MemoryChunk header that links to
+// the previous one.
+//
+// With ARDUINOJSON_ENABLE_FREE_LISTS, the freed variants form a linked list
+// stored in the variants themselves, and the freed strings form linked lists
+// stored in the strings, one per size class.
+
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+struct MemoryChunk {
+  MemoryChunk* next;
+  // the chunk that was current before this one
+  char* previousBegin;
+  char* previousEnd;
+};
+
+typedef void* (*AllocateFunction)(void* context, size_t size);
+typedef void (*DeallocateFunction)(void* context, void* ptr);
+
+// Chunks smaller than this would mostly contain headers
+const size_t minChunkSize = 16 * sizeof(VariantSlot);
+#endif
+
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+// The head of a freed string
+struct FreeString {
+  char* next;
+  size_t size;  // including stringHeaderSize
+};
+
+// The strings take a multiple of this size, so that a freed string can hold a
+// FreeString, and so that what remains of a reused string can be reused too
+const size_t stringGranularity = sizeof(FreeString);  // see JSON_STRING_SIZE
+
+// The freed strings of 1 to 7 granules are in exact-size lists, the larger
+// ones are in the last list
+const size_t freeStringClasses = 8;
+#endif
+
+#if ARDUINOJSON_ENABLE_STRING_DEDUP
+typedef StringTable<ARDUINOJSON_STRING_DEDUP_TABLE_SIZE> StringDedupTable;
+#endif
 
 class MemoryPool {
  public:
@@ -28,73 +75,296 @@ class MemoryPool {
       : _begin(buf),
         _left(buf),
         _right(buf ? buf + capa : 0),
-        _end(buf ? buf + capa : 0) {
+        _end(buf ? buf + capa : 0)
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+        ,
+        _allocate(0),
+        _deallocate(0),
+        _allocatorContext(0),
+        _chunks(0),
+        _chunkSize(0),
+        _retiredSize(0),
+        _retiredCapacity(0)
+#endif
+#if ARDUINOJSON_ENABLE_STRING_DEDUP
+        ,
+        _strings(0)
+#endif
+  {
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    discardFreeLists();
+#endif
+#if ARDUINOJSON_ENABLE_INCREMENTAL_GC
+    resetCollection();
+#endif
     ARDUINOJSON_ASSERT(isAligned(_begin));
     ARDUINOJSON_ASSERT(isAligned(_right));
     ARDUINOJSON_ASSERT(isAligned(_end));
   }
 
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+  // Allows the pool to allocate more chunks; each one is at least as large as
+  // the current capacity.
+  void setAllocator(void* context, AllocateFunction allocate,
+                    DeallocateFunction deallocate) {
+    _allocatorContext = context;
+    _allocate = allocate;
+    _deallocate = deallocate;
+    if (!_chunkSize)
+      _chunkSize = capacity() > minChunkSize ? capacity() : minChunkSize;
+  }
+
+  bool hasMultipleChunks() const {
+    return _chunks != 0;
+  }
+
+  // Releases the additional chunks, and makes the first one current again.
+  // The content of the pool is lost.
+  void freeChunks() {
+    while (_chunks) {
+      MemoryChunk* chunk = _chunks;
+      _begin = chunk->previousBegin;
+      _end = chunk->previousEnd;
+      _chunks = chunk->next;
+      _deallocate(_allocatorContext, chunk);
+    }
+    _left = _begin;
+    _right = _end;
+    _retiredSize = 0;
+    _retiredCapacity = 0;
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    discardFreeLists();
+#endif
+#if ARDUINOJSON_ENABLE_INCREMENTAL_GC
+    resetCollection();
+#endif
+  }
+#endif
+
   void* buffer() {
     return _begin;
   }
 
   const char* left() {
-    return (const char*) _left;
+    return _left;
   }
 
   VariantSlot* rootSlot() {
-		VariantSlot *root = (VariantSlot *)_end;
-		return --root;
-	}
+    return reinterpret_cast<VariantSlot*>(_end) - 1;
+  }
 
   // Gets the capacity of the memoryPool in bytes
   size_t capacity() const {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    return _retiredCapacity + size_t(_end - _begin);
+#else
     return size_t(_end - _begin);
+#endif
   }
 
   size_t size() const {
-    return size_t(_left - _begin + _end - _right);
+    size_t n = size_t(_left - _begin + _end - _right);
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    n += _retiredSize;
+#endif
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    n -= _freeSize;
+#endif
+    return n;
   }
 
   VariantSlot* allocVariant() {
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    if (_freeVariants) {
+      VariantSlot* slot = _freeVariants;
+      _freeVariants = *reinterpret_cast<VariantSlot**>(slot);
+      _freeSize -= sizeof(VariantSlot);
+      return slot;
+    }
+#endif
     return allocRight<VariantSlot>();
   }
 
+  // Gives back a variant that is no longer used
+  void freeVariant(VariantSlot* slot) {
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    if (reinterpret_cast<char*>(slot) == _right) {
+      _right += sizeof(VariantSlot);
+      return;
+    }
+    *reinterpret_cast<VariantSlot**>(slot) = _freeVariants;
+    _freeVariants = slot;
+    _freeSize += sizeof(VariantSlot);
+#else
+    (void)slot;
+#endif
+  }
+
+  // Gives back a string of n bytes, including the terminator, that is no
+  // longer used. Ignores the strings that are not in the current chunk, like
+  // the ones that deserializeJson() leaves in the input.
+  void freeString(const char* s, size_t n) {
+#if ARDUINOJSON_ENABLE_FREE_LISTS && !ARDUINOJSON_ENABLE_STRING_DEDUP
+    char* block = const_cast<char*>(s) - stringHeaderSize;
+    if (block < _begin || block >= _left)
+      return;
+    size_t size = stringBlockSize(n);
+    if (block + size == _left)
+      _left = block;
+    else
+      pushFreeString(block, size);
+#else
+    (void)s;
+    (void)n;
+#endif
+  }
+
+  // Allocates a string of n bytes, including the terminator
   char* allocFrozenString(size_t n) {
-    if (!canAlloc(n))
+#if ARDUINOJSON_ENABLE_FREE_LISTS && !ARDUINOJSON_ENABLE_STRING_DEDUP
+    char* block = popFreeString(stringBlockSize(n));
+    if (block) {
+      char* s = block + stringHeaderSize;
+#if ARDUINOJSON_STORE_STRING_LENGTH
+      setStoredLength(s, n - 1);
+#endif
+      return s;
+    }
+#endif
+    if (!reserve(stringBlockSize(n)))
       return 0;
-    char* s = _left;
-    _left += n;
+    char* s = _left + stringHeaderSize;
+    _left += stringBlockSize(n);
+#if ARDUINOJSON_STORE_STRING_LENGTH
+    setStoredLength(s, n - 1);
+#endif
     checkInvariants();
     return s;
   }
 
   StringSlot allocExpandableString() {
     StringSlot s;
-    s.value = _left;
-    s.size = size_t(_right - _left);
+    size_t available = size_t(_right - _left);
+#if ARDUINOJSON_ENABLE_FREE_LISTS && !ARDUINOJSON_ENABLE_STRING_DEDUP
+    // freezeString() rounds the size up to a multiple of stringGranularity
+    available -= available % stringGranularity;
+#endif
+    s.value = _left + stringHeaderSize;
+    s.size = available > stringHeaderSize ? available - stringHeaderSize : 0;
     _left = _right;
     checkInvariants();
     return s;
   }
 
+  // Makes room for at least minSize chars in the expandable string, which
+  // contains size chars. Returns false if the string can't grow.
+  bool growString(StringSlot& s, size_t size, size_t minSize) {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    // The string takes all the free space of the current chunk, so we move it
+    // to a new chunk. We ask for twice the size, so that a long string is
+    // copied a logarithmic number of times.
+    char* oldValue = s.value;
+    _left = oldValue - stringHeaderSize;
+    if (!addChunk(stringHeaderSize + 2 * minSize)) {
+      _left = _right;
+      return false;
+    }
+    memcpy(_left + stringHeaderSize, oldValue, size);
+    s = allocExpandableString();
+    return true;
+#else
+    (void)s;
+    (void)size;
+    (void)minSize;
+    return false;
+#endif
+  }
+
+  // newSize includes the terminator
   void freezeString(StringSlot& s, size_t newSize) {
-    _left -= (s.size - newSize);
+    _left = s.value - stringHeaderSize + stringBlockSize(newSize);
     s.size = newSize;
+#if ARDUINOJSON_STORE_STRING_LENGTH
+    setStoredLength(s.value, newSize - 1);
+#endif
     checkInvariants();
   }
 
   void reclaimLastString(const char* s) {
-    _left = const_cast<char*>(s);
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    // the string may be in a previous chunk
+    if (s < _begin || s > _left)
+      return;
+#endif
+    _left = const_cast<char*>(s) - stringHeaderSize;
   }
 
+  // Returns an identical string stored earlier in the current
+  // StringDedupScope, if any, and releases s, which must be the last string
+  // stored
+  const char* deduplicate(const char* s) {
+#if ARDUINOJSON_ENABLE_STRING_DEDUP
+    if (!_strings || !s)
+      return s;
+    const char* existing = _strings->add(s);
+    if (existing != s)
+      reclaimLastString(s);
+    return existing;
+#else
+    return s;
+#endif
+  }
+
+#if ARDUINOJSON_ENABLE_STRING_DEDUP
+  StringDedupTable* stringTable() const {
+    return _strings;
+  }
+
+  void setStringTable(StringDedupTable* table) {
+    _strings = table;
+  }
+#endif
+
   void clear() {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    if (_chunks)
+      mergeChunks();
+#endif
     _left = _begin;
     _right = _end;
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    discardFreeLists();
+#endif
+#if ARDUINOJSON_ENABLE_INCREMENTAL_GC
+    resetCollection();
+#endif
+  }
+
+  // Gets the number of bytes that a string of n bytes, including the
+  // terminator, takes in the pool
+  // Returns SIZE_MAX if the size overflows, so that no pool can hold it
+  static size_t stringBlockSize(size_t n) {
+    size_t size = stringHeaderSize + n;
+    if (size < n)
+      return size_t(-1);
+#if ARDUINOJSON_ENABLE_FREE_LISTS && !ARDUINOJSON_ENABLE_STRING_DEDUP
+    // even an empty value, like serialized(""), must have room for the
+    // FreeString that replaces it when it's freed
+    if (size < stringGranularity)
+      return stringGranularity;
+    size_t remainder = size % stringGranularity;
+    if (remainder) {
+      if (size > size_t(-1) - stringGranularity)
+        return size_t(-1);
+      size += stringGranularity - remainder;
+    }
+#endif
+    return size;
   }
 
+  // bytes may come from the input, so _left + bytes could wrap
   bool canAlloc(size_t bytes) const {
-    return _left + bytes <= _right;
+    return bytes <= size_t(_right - _left);
   }
 
   bool owns(void* p) const {
@@ -107,7 +377,7 @@ class MemoryPool {
   }
 
   void* allocRight(size_t bytes) {
-    if (!canAlloc(bytes))
+    if (!reserve(bytes))
       return 0;
     _right -= bytes;
     return _right;
@@ -130,6 +400,17 @@ class MemoryPool {
   //
   // This funcion is called before a realloc.
   ptrdiff_t squash() {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    ARDUINOJSON_ASSERT(!_chunks);
+#endif
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    // the freed variants would move, so we forget them
+    discardFreeLists();
+#endif
+#if ARDUINOJSON_ENABLE_INCREMENTAL_GC
+    // the strings would move too
+    resetCollection();
+#endif
     char* new_right = addPadding(_left);
     if (new_right >= _right)
       return 0;
@@ -152,11 +433,291 @@ class MemoryPool {
     _end += offset;
   }
 
+  // Clears the marks that may remain in the memory of the dead variants, so
+  // that only the live ones are marked (see JsonDocument::compact())
+  void unmarkVariants() {
+    VariantSlot* slot = reinterpret_cast<VariantSlot*>(_right);
+    for (; slot < reinterpret_cast<VariantSlot*>(_end); slot++)
+      if (slot->isMarked())
+        slot->clear();
+  }
+
+  // Moves the marked variants to the right, and frees the others.
+  // Returns false if it stopped after maxMoves, leaving the free variants
+  // where they are.
+  //
+  // It moves the leftmost marked variants to the rightmost holes, and leaves
+  // their new address in their old place, until the variants meet the holes.
+  bool compactVariants(size_t maxMoves = size_t(-1)) {
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    discardFreeLists();
+#endif
+    VariantSlot* live = reinterpret_cast<VariantSlot*>(_right);
+    VariantSlot* hole = reinterpret_cast<VariantSlot*>(_end);
+    for (;;) {
+      while (hole > live && hole[-1].isMarked()) hole--;
+      while (live < hole && !live->isMarked()) live++;
+      if (live >= hole)
+        break;
+      if (!maxMoves--)
+        return false;
+      hole--;
+      live->moveTo(hole);
+      live->clear();
+      *reinterpret_cast<VariantSlot**>(live) = hole;
+      live++;
+    }
+    _right = reinterpret_cast<char*>(hole);
+    return true;
+  }
+
+  // Gets the new address of a variant, after compactVariants().
+  // The variants that moved are no longer marked.
+  VariantSlot* forwardVariant(VariantSlot* slot) const {
+    if (!slot || slot->isMarked())
+      return slot;
+    return *reinterpret_cast<VariantSlot**>(slot);
+  }
+
+  StringCompaction startStringCompaction() const {
+    StringCompaction progress = {_begin, _begin, _begin, 0, 0};
+    return progress;
+  }
+
+  // Slides the next batch of the strings that the root references to the
+  // left, moving at most maxBytes, unless the first string is larger.
+  // Returns false, and frees the others, when all the strings moved.
+  // Otherwise, forwardStrings() updates the references that the batch missed.
+  //
+  // It moves the strings in the order of their addresses, so it never
+  // overwrites a string that it hasn't moved yet. The batch goes in the
+  // largest free space: on the stack, between the strings and the variants,
+  // or in the hole that the moved strings left behind them.
+  template <typename TRoot>
+  bool compactStrings(TRoot& root, StringCompaction& progress,
+                      size_t maxBytes = size_t(-1)) {
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    // the freed strings may be in the way
+    discardFreeLists();
+#endif
+    StringReference local[stringCollectorSize];
+    StringReference* batch = local;
+    size_t capacity = stringCollectorSize;
+    // the strings that move must stay below this, to spare the batch
+    char* limit = _left;
+    char* scratch = addPadding(_left);
+    if (scratchCapacity(scratch, _right) > capacity) {
+      batch = reinterpret_cast<StringReference*>(scratch);
+      capacity = scratchCapacity(scratch, _right);
+    }
+    // the upper half of the hole holds the batch, the strings move to the
+    // lower half
+    scratch = addPadding(progress.dst + (progress.holeEnd - progress.dst) / 2);
+    if (scratchCapacity(scratch, progress.holeEnd) > capacity) {
+      batch = reinterpret_cast<StringReference*>(scratch);
+      capacity = scratchCapacity(scratch, progress.holeEnd);
+      limit = scratch;
+    }
+
+    StringCollector collector(batch, capacity, _begin, _left, progress);
+    root.collectStrings(collector);
+    size_t n = collector.sort();
+
+    size_t moved = 0;
+    size_t i = 0;
+    while (i < n && progress.dst <= limit) {
+      const char* s = *collector[i].ref;
+      // the references may not agree on the size, if one of them is empty
+      size_t size = 0;
+      size_t j = i;
+      for (; j < n && *collector[j].ref == s; j++)
+        if (collector[j].size > size)
+          size = collector[j].size;
+      size = stringBlockSize(size);
+      // the first string moves anyway, as the batch is no longer needed
+      if (i > 0 && (progress.dst + size > limit || moved + size > maxBytes))
+        break;
+      char* block = const_cast<char*>(s) - stringHeaderSize;
+      const char* to = progress.dst + stringHeaderSize;
+      for (; i < j; i++) *collector[i].ref = to;
+      if (progress.dst != block) {
+        memmove(progress.dst, block, size);
+        moved += size;
+      }
+      progress.dst += size;
+      progress.holeEnd = block + size;
+      progress.floor = s + 1;
+      progress.movedFrom = s;
+      progress.movedTo = to;
+    }
+    // only the last string of a full batch may have references outside
+    if (i < n) {
+      progress.movedFrom = 0;
+      return true;
+    }
+    if (n == capacity)
+      return true;
+    _left = progress.dst;
+    checkInvariants();
+    return false;
+  }
+
+  // Updates the references to the last string that compactStrings() moved
+  template <typename TRoot>
+  void forwardStrings(TRoot& root, StringCompaction& progress) const {
+    if (!progress.movedFrom)
+      return;
+    StringCollector collector(0, 0, _begin, _left, progress);
+    root.collectStrings(collector);
+    progress.movedFrom = 0;
+  }
+
+#if ARDUINOJSON_ENABLE_INCREMENTAL_GC
+  // The progress of JsonDocument::collectStep(), which is compacting the
+  // variants while dst is NULL
+  StringCompaction& collection() {
+    return _collection;
+  }
+
+  void resetCollection() {
+    _collection.dst = 0;
+  }
+#endif
+
  private:
   StringSlot* allocStringSlot() {
     return allocRight<StringSlot>();
   }
 
+  bool reserve(size_t bytes) {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    return canAlloc(bytes) || addChunk(bytes);
+#else
+    return canAlloc(bytes);
+#endif
+  }
+
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+  // Makes a new chunk current. The slots link to each other with
+  // VariantSlotDiff, which counts in slots, so the end of the new chunk is
+  // aligned like the end of the first chunk.
+  bool addChunk(size_t bytes) {
+    // the header and the padding must not wrap the size of the chunk
+    if (!_allocate || bytes > size_t(-1) / 2)
+      return false;
+    size_t capa = addPadding(bytes > _chunkSize ? bytes : _chunkSize);
+    char* raw = reinterpret_cast<char*>(
+        _allocate(_allocatorContext,
+                  sizeof(MemoryChunk) + capa + sizeof(VariantSlot)));
+    if (!raw)
+      return false;
+
+    MemoryChunk* chunk = reinterpret_cast<MemoryChunk*>(raw);
+    chunk->next = _chunks;
+    chunk->previousBegin = _begin;
+    chunk->previousEnd = _end;
+    _chunks = chunk;
+
+    _retiredSize += size_t(_left - _begin + _end - _right);
+    _retiredCapacity += size_t(_end - _begin);
+
+    char* end = raw + sizeof(MemoryChunk) + capa + sizeof(VariantSlot);
+    end -= slotOffset(end, _end);
+    _begin = _left = raw + sizeof(MemoryChunk);
+    _right = _end = end;
+#if ARDUINOJSON_ENABLE_INCREMENTAL_GC
+    resetCollection();
+#endif
+    checkInvariants();
+    return true;
+  }
+
+  // Replaces all the chunks with a single one, so that the next use of the
+  // pool doesn't need to allocate again. Keeps the chunks, empty, if the
+  // allocator fails, so that the capacity stays the same.
+  void mergeChunks() {
+    size_t capa = capacity();
+    char* buf = reinterpret_cast<char*>(_allocate(_allocatorContext, capa));
+    if (!buf) {
+      _retiredSize = 0;
+      return;
+    }
+    freeChunks();
+    _deallocate(_allocatorContext, _begin);
+    _begin = buf;
+    _end = buf + capa;
+  }
+
+  // Number of bytes between p and the previous address that is aligned on
+  // the slots that end at ref
+  static size_t slotOffset(const char* p, const char* ref) {
+    const size_t n = sizeof(VariantSlot);
+    size_t a = reinterpret_cast<uintptr_t>(p) % n;
+    size_t b = reinterpret_cast<uintptr_t>(ref) % n;
+    return (a + n - b) % n;
+  }
+#endif
+
+  // Gets the number of references that fit between begin and end
+  static size_t scratchCapacity(const char* begin, const char* end) {
+    return begin < end ? size_t(end - begin) / sizeof(StringReference) : 0;
+  }
+
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  void discardFreeLists() {
+    _freeVariants = 0;
+    for (size_t i = 0; i < freeStringClasses; i++) _freeStrings[i] = 0;
+    _freeSize = 0;
+  }
+
+  static size_t freeStringClass(size_t size) {
+    size_t granules = size / stringGranularity;
+    return granules < freeStringClasses ? granules - 1 : freeStringClasses - 1;
+  }
+
+  static FreeString readFreeString(const char* block) {
+    FreeString head;
+    memcpy(&head, block, sizeof(head));
+    return head;
+  }
+
+  void pushFreeString(char* block, size_t size) {
+    size_t i = freeStringClass(size);
+    FreeString head = {_freeStrings[i], size};
+    memcpy(block, &head, sizeof(head));
+    _freeStrings[i] = block;
+    _freeSize += size;
+  }
+
+  // Returns a freed string of at least size bytes, or NULL.
+  // The strings of the last list may be too small; the others are not.
+  char* popFreeString(size_t size) {
+    for (size_t i = freeStringClass(size); i < freeStringClasses; i++) {
+      char* prev = 0;
+      char* block = _freeStrings[i];
+      while (block) {
+        FreeString head = readFreeString(block);
+        if (head.size >= size) {
+          if (prev) {
+            FreeString prevHead = readFreeString(prev);
+            prevHead.next = head.next;
+            memcpy(prev, &prevHead, sizeof(prevHead));
+          } else {
+            _freeStrings[i] = head.next;
+          }
+          _freeSize -= head.size;
+          if (head.size > size)
+            pushFreeString(block + size, head.size - size);
+          return block;
+        }
+        prev = block;
+        block = head.next;
+      }
+    }
+    return 0;
+  }
+#endif
+
   void checkInvariants() {
     ARDUINOJSON_ASSERT(_begin <= _left);
     ARDUINOJSON_ASSERT(_left <= _right);
@@ -165,6 +726,92 @@ class MemoryPool {
   }
 
   char *_begin, *_left, *_right, *_end;
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+  AllocateFunction _allocate;
+  DeallocateFunction _deallocate;
+  void* _allocatorContext;
+  MemoryChunk* _chunks;
+  size_t _chunkSize;
+  // the bytes used, and the bytes available, in the previous chunks
+  size_t _retiredSize;
+  size_t _retiredCapacity;
+#endif
+#if ARDUINOJSON_ENABLE_STRING_DEDUP
+  StringDedupTable* _strings;
+#endif
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  VariantSlot* _freeVariants;
+  char* _freeStrings[freeStringClasses];
+  // the bytes in the free lists
+  size_t _freeSize;
+#endif
+#if ARDUINOJSON_ENABLE_INCREMENTAL_GC
+  StringCompaction _collection;
+#endif
+};
+
+// Adds up the bytes of the strings that a value references in a MemoryPool
+// (see JsonDocument::fragmentation())
+class StringCounter {
+ public:
+  StringCounter(const MemoryPool& pool)
+      : _pool(pool), _counted(0), _pooled(0) {}
+
+  void addString(const char*& s) {
+    add(s, storedLength(s) + 1);
+  }
+
+  void addString(const char*& s, size_t n) {
+    add(s, n);
+  }
+
+  // The bytes that VariantData::memoryUsage() counts for the strings
+  size_t counted() const {
+    return _counted;
+  }
+
+  // The bytes that the strings take in the pool
+  size_t pooled() const {
+    return _pooled;
+  }
+
+ private:
+  void add(const char* s, size_t n) {
+    _counted += stringHeaderSize + n;
+    if (_pool.owns(const_cast<char*>(s) - stringHeaderSize))
+      _pooled += MemoryPool::stringBlockSize(n);
+  }
+
+  const MemoryPool& _pool;
+  size_t _counted;
+  size_t _pooled;
+};
+
+// Makes the MemoryPool deduplicate the strings it stores, until the end of the
+// scope. Nested scopes use the table of the outermost one.
+class StringDedupScope {
+ public:
+#if ARDUINOJSON_ENABLE_STRING_DEDUP
+  StringDedupScope(MemoryPool& pool)
+      : _pool(pool), _previous(pool.stringTable()) {
+    if (!_previous)
+      _pool.setStringTable(&_table);
+  }
+
+  ~StringDedupScope() {
+    _pool.setStringTable(_previous);
+  }
+
+ private:
+  StringDedupScope(const StringDedupScope&);
+  StringDedupScope& operator=(const StringDedupScope&);
+
+  MemoryPool& _pool;
+  StringDedupTable* _previous;
+  StringDedupTable _table;
+#else
+  StringDedupScope(MemoryPool&) {}
+#endif
 };
 
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,106 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Alignment.hpp>
+
+#include <string.h>  // memcpy
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Allocates from a buffer by moving a pointer, and frees everything at once
+// with reset(), like at the end of a request. Until then, deallocate() only
+// frees the last block, and reallocate() only resizes the last block in
+// place; it shrinks the other blocks in place, and moves them to grow them.
+// Each block starts with a header that holds its size.
+//
+// It's not thread-safe, but each thread can have its own.
+class MonotonicArena {
+ public:
+  MonotonicArena(void* buf, size_t capa)
+      : _begin(static_cast<char*>(buf)),
+        _last(0),
+        _top(_begin),
+        _end(_begin + capa) {}
+
+  void* allocate(size_t size) {
+    char* block = addPadding(_top);
+    if (block > _end || size_t(_end - block) < headerSize ||
+        size_t(_end - block) - headerSize < size)
+      return 0;
+    char* p = block + headerSize;
+    setSize(p, size);
+    _last = p;
+    _top = p + size;
+    return p;
+  }
+
+  void deallocate(void* ptr) {
+    if (!ptr || ptr != _last)
+      return;
+    _top = _last - headerSize;
+    _last = 0;
+  }
+
+  void* reallocate(void* ptr, size_t new_size) {
+    if (!ptr)
+      return allocate(new_size);
+    char* p = static_cast<char*>(ptr);
+    if (p == _last) {
+      if (size_t(_end - p) < new_size)
+        return 0;
+      setSize(p, new_size);
+      _top = p + new_size;
+      return p;
+    }
+    size_t size = getSize(p);
+    if (new_size <= size) {
+      setSize(p, new_size);
+      return p;
+    }
+    void* bigger = allocate(new_size);
+    if (bigger)
+      memcpy(bigger, p, size);
+    return bigger;
+  }
+
+  void reset() {
+    _last = 0;
+    _top = _begin;
+  }
+
+  // Gets the number of bytes allocated since the last reset(), including the
+  // headers
+  size_t size() const {
+    return size_t(_top - _begin);
+  }
+
+  size_t capacity() const {
+    return size_t(_end - _begin);
+  }
+
+ private:
+  MonotonicArena(const MonotonicArena&);
+  MonotonicArena& operator=(const MonotonicArena&);
+
+  static const size_t headerSize = AddPadding<sizeof(size_t)>::value;
+
+  static void setSize(char* p, size_t size) {
+    memcpy(p - headerSize, &size, sizeof(size));
+  }
+
+  static size_t getSize(const char* p) {
+    size_t size;
+    memcpy(&size, p - headerSize, sizeof(size));
+    return size;
+  }
+
+  char* _begin;
+  char* _last;
+  char* _top;
+  char* _end;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,230 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/Alignment.hpp>
+
+#include <string.h>  // memcpy
+
+#if ARDUINOJSON_ENABLE_STD_ATOMIC
+#include <stdint.h>  // uint32_t, uint64_t
+#include <atomic>
+#endif
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// The blocks of a slab allocator have a size class: the smallest one takes
+// slabMinBlockSize bytes, and each following one takes twice as many. Each
+// block starts with a header that holds its class.
+const size_t slabMinBlockSize = 32;
+const size_t slabClasses = 20;
+const size_t slabHeaderSize = AddPadding<sizeof(size_t)>::value;
+
+inline size_t slabBlockSize(size_t sizeClass) {
+  return slabMinBlockSize << sizeClass;
+}
+
+// Gets the class of the blocks that can hold size bytes, or slabClasses if
+// they are too large
+inline size_t slabClassFor(size_t size) {
+  size_t sizeClass = 0;
+  while (sizeClass < slabClasses &&
+         slabBlockSize(sizeClass) - slabHeaderSize < size)
+    sizeClass++;
+  return sizeClass;
+}
+
+inline void slabSetClass(char* block, size_t sizeClass) {
+  memcpy(block, &sizeClass, sizeof(sizeClass));
+}
+
+inline size_t slabGetClass(const void* ptr) {
+  size_t sizeClass;
+  memcpy(&sizeClass, static_cast<const char*>(ptr) - slabHeaderSize,
+         sizeof(sizeClass));
+  return sizeClass;
+}
+
+// Allocates blocks of a few sizes from a buffer, and keeps the freed blocks in
+// one list per size, so it allocates and frees in constant time.
+//
+// It's not thread-safe, but each thread can have its own; see
+// SharedSlabAllocator otherwise.
+class SlabAllocator {
+ public:
+  SlabAllocator(void* buf, size_t capa)
+      : _top(addPadding(static_cast<char*>(buf))),
+        _end(static_cast<char*>(buf) + capa) {
+    for (size_t i = 0; i < slabClasses; i++) _free[i] = 0;
+  }
+
+  void* allocate(size_t size) {
+    size_t sizeClass = slabClassFor(size);
+    if (sizeClass >= slabClasses)
+      return 0;
+    char* block = _free[sizeClass];
+    if (block) {
+      memcpy(&_free[sizeClass], block + slabHeaderSize, sizeof(char*));
+      return block + slabHeaderSize;
+    }
+    size_t blockSize = slabBlockSize(sizeClass);
+    if (_top > _end || size_t(_end - _top) < blockSize)
+      return 0;
+    block = _top;
+    _top += blockSize;
+    slabSetClass(block, sizeClass);
+    return block + slabHeaderSize;
+  }
+
+  void deallocate(void* ptr) {
+    if (!ptr)
+      return;
+    size_t sizeClass = slabGetClass(ptr);
+    memcpy(ptr, &_free[sizeClass], sizeof(char*));
+    _free[sizeClass] = static_cast<char*>(ptr) - slabHeaderSize;
+  }
+
+  // Keeps the block if it's large enough
+  void* reallocate(void* ptr, size_t new_size) {
+    if (!ptr)
+      return allocate(new_size);
+    size_t capa = slabBlockSize(slabGetClass(ptr)) - slabHeaderSize;
+    if (new_size <= capa)
+      return ptr;
+    void* bigger = allocate(new_size);
+    if (!bigger)
+      return 0;
+    memcpy(bigger, ptr, capa);
+    deallocate(ptr);
+    return bigger;
+  }
+
+ private:
+  SlabAllocator(const SlabAllocator&);
+  SlabAllocator& operator=(const SlabAllocator&);
+
+  char* _top;
+  char* _end;
+  char* _free[slabClasses];
+};
+
+#if ARDUINOJSON_ENABLE_STD_ATOMIC
+// A SlabAllocator that many threads can share, without locks.
+//
+// Each list of freed blocks is a stack whose head packs the offset of the
+// first block with a counter that changes at each push and pop, so that a
+// thread can't pop a block that another one popped and pushed again in the
+// meantime. The buffer can't exceed 4 GB.
+class SharedSlabAllocator {
+ public:
+  SharedSlabAllocator(void* buf, size_t capa)
+      : _begin(addPadding(static_cast<char*>(buf))), _top(0) {
+    size_t padding = size_t(_begin - static_cast<char*>(buf));
+    _capacity = capa > padding ? capa - padding : 0;
+    if (_capacity > 0xFFFFFFFE)
+      _capacity = 0xFFFFFFFE;
+    for (size_t i = 0; i < slabClasses; i++) _free[i].store(0);
+  }
+
+  void* allocate(size_t size) {
+    size_t sizeClass = slabClassFor(size);
+    if (sizeClass >= slabClasses)
+      return 0;
+    char* block = pop(sizeClass);
+    if (!block) {
+      block = carve(slabBlockSize(sizeClass));
+      if (!block)
+        return 0;
+      slabSetClass(block, sizeClass);
+    }
+    return block + slabHeaderSize;
+  }
+
+  void deallocate(void* ptr) {
+    if (!ptr)
+      return;
+    push(static_cast<char*>(ptr) - slabHeaderSize, slabGetClass(ptr));
+  }
+
+  // Keeps the block if it's large enough
+  void* reallocate(void* ptr, size_t new_size) {
+    if (!ptr)
+      return allocate(new_size);
+    size_t capa = slabBlockSize(slabGetClass(ptr)) - slabHeaderSize;
+    if (new_size <= capa)
+      return ptr;
+    void* bigger = allocate(new_size);
+    if (!bigger)
+      return 0;
+    memcpy(bigger, ptr, capa);
+    deallocate(ptr);
+    return bigger;
+  }
+
+ private:
+  SharedSlabAllocator(const SharedSlabAllocator&);
+  SharedSlabAllocator& operator=(const SharedSlabAllocator&);
+
+  typedef std::atomic<uint32_t> Link;
+
+  // A freed block links to the next one, after its header.
+  // Another thread may read the link while it pops the same block.
+  static Link* linkOf(char* block) {
+    return reinterpret_cast<Link*>(block + slabHeaderSize);
+  }
+
+  // The offset of the block plus one, so that zero means NULL
+  uint32_t indexOf(const char* block) const {
+    return uint32_t(block - _begin + 1);
+  }
+
+  static uint64_t makeHead(uint64_t previous, uint32_t index) {
+    return (((previous >> 32) + 1) << 32) | index;
+  }
+
+  // Takes a new block from the rest of the buffer
+  char* carve(size_t blockSize) {
+    size_t offset = _top.load(std::memory_order_relaxed);
+    do {
+      if (blockSize > _capacity || offset > _capacity - blockSize)
+        return 0;
+    } while (!_top.compare_exchange_weak(offset, offset + blockSize,
+                                         std::memory_order_relaxed));
+    return _begin + offset;
+  }
+
+  void push(char* block, size_t sizeClass) {
+    Link* link = linkOf(block);
+    uint64_t head = _free[sizeClass].load(std::memory_order_relaxed);
+    do {
+      link->store(uint32_t(head), std::memory_order_relaxed);
+    } while (!_free[sizeClass].compare_exchange_weak(
+        head, makeHead(head, indexOf(block)), std::memory_order_release,
+        std::memory_order_relaxed));
+  }
+
+  char* pop(size_t sizeClass) {
+    uint64_t head = _free[sizeClass].load(std::memory_order_acquire);
+    for (;;) {
+      uint32_t index = uint32_t(head);
+      if (!index)
+        return 0;
+      char* block = _begin + index - 1;
+      uint32_t next = linkOf(block)->load(std::memory_order_relaxed);
+      if (_free[sizeClass].compare_exchange_weak(head, makeHead(head, next),
+                                                 std::memory_order_acquire,
+                                                 std::memory_order_acquire))
+        return block;
+    }
+  }
+
+  char* _begin;
+  size_t _capacity;
+  std::atomic<size_t> _top;
+  std::atomic<uint64_t> _free[slabClasses];
+};
+#endif
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -6,6 +6,8 @@
 
 #include <ArduinoJson/Memory/MemoryPool.hpp>
 
+#include <string.h>  // memcpy, strlen
+
 namespace ARDUINOJSON_NAMESPACE {
 
 class StringBuilder {
@@ -15,18 +17,28 @@ class StringBuilder {
   }
 
   void append(const char* s) {
-    while (*s) append(*s++);
+    append(s, strlen(s));
   }
 
   void append(const char* s, size_t n) {
-    while (n-- > 0) append(*s++);
+    if (!_slot.value)
+      return;
+
+    if (n > _slot.size - _size &&
+        !_parent->growString(_slot, _size, _size + n)) {
+      _slot.value = 0;
+      return;
+    }
+
+    memcpy(_slot.value + _size, s, n);
+    _size += n;
   }
 
   void append(char c) {
     if (!_slot.value)
       return;
 
-    if (_size >= _slot.size) {
+    if (_size >= _slot.size && !_parent->growString(_slot, _size, _size + 1)) {
       _slot.value = 0;
       return;
     }
@@ -0,0 +1,145 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/StringSlot.hpp>
+
+#include <stddef.h>  // size_t
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// A pointer to a string of the MemoryPool, in a key or in a value
+struct StringReference {
+  const char** ref;
+  size_t size;  // including the terminator, if any
+};
+
+// How far MemoryPool::compactStrings() went
+struct StringCompaction {
+  char* dst;           // the strings below are compact
+  char* holeEnd;       // the strings above haven't moved
+  const char* floor;   // the references below point to strings that moved
+  const char* movedFrom;  // the last string that moved, whose references
+  const char* movedTo;    // may not all be updated yet
+};
+
+// The number of references that MemoryPool::compactStrings() can sort without
+// using the free space of the pool
+const size_t stringCollectorSize = 16;
+
+// Collects the references to the strings of a MemoryPool that are above a
+// floor, and keeps the ones to the lowest addresses, so that
+// MemoryPool::compactStrings() can slide the strings in order.
+//
+// The references are in a max-heap, until sort() sorts them by address.
+class StringCollector {
+ public:
+  // With a capacity of zero, it only updates the references to the string
+  // that moved last.
+  StringCollector(StringReference* items, size_t capacity, const char* begin,
+                  const char* end, const StringCompaction& progress)
+      : _items(items),
+        _capacity(capacity),
+        _size(0),
+        _begin(begin),
+        _end(end),
+        _progress(progress) {}
+
+  // A string that ends with a terminator
+  void addString(const char*& s) {
+    if (accepts(s))
+      add(s, storedLength(s) + 1);
+  }
+
+  // A string of n bytes
+  void addString(const char*& s, size_t n) {
+    if (accepts(s))
+      add(s, n);
+  }
+
+  // Sorts the references by address, and returns how many there are
+  size_t sort() {
+    for (size_t n = _size; n > 1; n--) {
+      swap(0, n - 1);
+      siftDown(0, n - 1);
+    }
+    return _size;
+  }
+
+  const StringReference& operator[](size_t i) const {
+    return _items[i];
+  }
+
+ private:
+  bool accepts(const char*& s) {
+    if (s - stringHeaderSize < _begin || s >= _end)
+      return false;  // not in the pool, like the strings in the input
+    if (s == _progress.movedFrom) {
+      s = _progress.movedTo;
+      return false;
+    }
+    if (s < _progress.floor)
+      return false;  // already moved
+    return _size < _capacity || (_size && s < *_items[0].ref);
+  }
+
+  void add(const char*& s, size_t n) {
+    StringReference item = {&s, n};
+    if (_size < _capacity) {
+      size_t i = _size++;
+      _items[i] = item;
+      siftUp(i);
+    } else {
+      // replace the highest address
+      _items[0] = item;
+      siftDown(0, _size);
+    }
+  }
+
+  bool less(size_t i, size_t j) const {
+    return *_items[i].ref < *_items[j].ref;
+  }
+
+  void swap(size_t i, size_t j) {
+    StringReference tmp = _items[i];
+    _items[i] = _items[j];
+    _items[j] = tmp;
+  }
+
+  void siftUp(size_t i) {
+    while (i > 0) {
+      size_t parent = (i - 1) / 2;
+      if (!less(parent, i))
+        return;
+      swap(parent, i);
+      i = parent;
+    }
+  }
+
+  void siftDown(size_t i, size_t n) {
+    for (;;) {
+      size_t largest = i;
+      size_t left = 2 * i + 1;
+      size_t right = left + 1;
+      if (left < n && less(largest, left))
+        largest = left;
+      if (right < n && less(largest, right))
+        largest = right;
+      if (largest == i)
+        return;
+      swap(i, largest);
+      i = largest;
+    }
+  }
+
+  StringReference* _items;
+  size_t _capacity;
+  size_t _size;
+  const char* _begin;
+  const char* _end;
+  const StringCompaction& _progress;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -5,10 +5,28 @@
 #pragma once
 
 #include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint8_t
+#include <string.h>  // for memchr, strlen
 
 #include <ArduinoJson/Namespace.hpp>
 
-#define JSON_STRING_SIZE(SIZE) (SIZE)
+#if ARDUINOJSON_STORE_STRING_LENGTH
+#define ARDUINOJSON_STRING_HEADER_SIZE 2
+#else
+#define ARDUINOJSON_STRING_HEADER_SIZE 0
+#endif
+
+#if ARDUINOJSON_ENABLE_FREE_LISTS && !ARDUINOJSON_ENABLE_STRING_DEDUP
+// Like MemoryPool::stringBlockSize(), rounds up to a multiple of
+// sizeof(FreeString)
+#define ARDUINOJSON_STRING_GRANULARITY (sizeof(char *) + sizeof(size_t))
+#define JSON_STRING_SIZE(SIZE)                                         \
+  (((SIZE) + ARDUINOJSON_STRING_HEADER_SIZE +                          \
+    ARDUINOJSON_STRING_GRANULARITY - 1) /                              \
+   ARDUINOJSON_STRING_GRANULARITY * ARDUINOJSON_STRING_GRANULARITY)
+#else
+#define JSON_STRING_SIZE(SIZE) ((SIZE) + ARDUINOJSON_STRING_HEADER_SIZE)
+#endif
 
 namespace ARDUINOJSON_NAMESPACE {
 
@@ -16,4 +34,41 @@ struct StringSlot {
   char *value;
   size_t size;
 };
+
+// With ARDUINOJSON_STORE_STRING_LENGTH, the strings of the MemoryPool are
+// preceded by their length, on two bytes (little-endian). A string of 0xFFFF
+// chars or more stores 0xFFFF.
+const size_t stringHeaderSize = ARDUINOJSON_STRING_HEADER_SIZE;
+
+#if ARDUINOJSON_STORE_STRING_LENGTH
+inline void setStoredLength(char *s, size_t n) {
+  if (n > 0xFFFF)
+    n = 0xFFFF;
+  s[-2] = char(n & 0xFF);
+  s[-1] = char(n >> 8);
+}
+#endif
+
+// Gets the length of a string stored in the MemoryPool
+inline size_t storedLength(const char *s) {
+#if ARDUINOJSON_STORE_STRING_LENGTH
+  size_t n = size_t(uint8_t(s[-2])) | size_t(uint8_t(s[-1])) << 8;
+  if (n < 0xFFFF)
+    return n;
+#endif
+  return strlen(s);
+}
+
+// Makes the stored length of a string of n chars stop at the first NUL, if
+// any, because the rest of the library reads the strings as C strings
+inline void truncateStoredLength(char *s, size_t n) {
+#if ARDUINOJSON_STORE_STRING_LENGTH
+  const char *nul = static_cast<const char *>(memchr(s, 0, n));
+  if (nul)
+    setStoredLength(s, size_t(nul - s));
+#else
+  (void)s;
+  (void)n;
+#endif
+}
 }  // namespace ARDUINOJSON_NAMESPACE
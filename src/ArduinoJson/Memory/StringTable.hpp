@@ -0,0 +1,49 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Strings/ConstRamStringAdapter.hpp>
+#include <ArduinoJson/Strings/hashString.hpp>
+
+#include <string.h>  // memset, strcmp
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Hash set of the strings stored in a MemoryPool during a StringDedupScope
+// (see ARDUINOJSON_ENABLE_STRING_DEDUP)
+//
+// Like ObjectIndex, it uses open addressing with linear probing, but the
+// buckets are on the stack, so the capacity is fixed. Once the table is
+// 3/4 full, it stops adding strings, so the lookups stay short; the strings
+// are still correct, they're just not deduplicated anymore.
+template <size_t capacity>
+class StringTable {
+ public:
+  StringTable() : _size(0) {
+    memset(_buckets, 0, sizeof(_buckets));
+  }
+
+  // Returns the string equal to str, if any.
+  // Otherwise, adds str to the table, and returns it.
+  const char* add(const char* str) {
+    size_t i = hashString(ConstRamStringAdapter(str)) % capacity;
+    while (_buckets[i]) {
+      if (!strcmp(_buckets[i], str))
+        return _buckets[i];
+      i = (i + 1) % capacity;
+    }
+    if (4 * (_size + 1) <= 3 * capacity) {
+      _buckets[i] = str;
+      _size++;
+    }
+    return str;
+  }
+
+ private:
+  const char* _buckets[capacity];
+  size_t _size;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,34 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint8_t
+
+#include <ArduinoJson/Namespace.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// A MessagePack bin value: a slice of bytes that is not a string.
+// VariantRef::set() copies the bytes; VariantRef::as() doesn't.
+class MsgPackBinary {
+ public:
+  MsgPackBinary() : _data(0), _size(0) {}
+  MsgPackBinary(const void* data, size_t size)
+      : _data(reinterpret_cast<const uint8_t*>(data)), _size(size) {}
+
+  const uint8_t* data() const {
+    return _data;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+ private:
+  const uint8_t* _data;
+  size_t _size;
+};
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -15,25 +15,86 @@ namespace ARDUINOJSON_NAMESPACE {
 
 template <typename TReader, typename TStringStorage>
 class MsgPackDeserializer {
-  typedef typename remove_reference<TStringStorage>::type::StringBuilder
-      StringBuilder;
-
  public:
   MsgPackDeserializer(MemoryPool &pool, TReader reader,
                       TStringStorage stringStorage)
       : _pool(&pool), _reader(reader), _stringStorage(stringStorage) {}
 
-  // TODO: add support for filter
-  DeserializationError parse(VariantData &variant, AllowAllFilter,
+  template <typename TFilter>
+  DeserializationError parse(VariantData &variant, TFilter filter,
                              NestingLimit nestingLimit) {
-    return parse(variant, nestingLimit);
+    return parseVariant(variant, filter, nestingLimit);
   }
 
-  DeserializationError parse(VariantData &variant, NestingLimit nestingLimit) {
+ private:
+  // Prevent VS warning "assignment operator could not be generated"
+  MsgPackDeserializer &operator=(const MsgPackDeserializer &);
+
+  template <typename TFilter>
+  DeserializationError parseVariant(VariantData &variant, TFilter filter,
+                                    NestingLimit nestingLimit) {
     uint8_t code;
     if (!readByte(code))
       return DeserializationError::IncompleteInput;
 
+    if ((code & 0xf0) == 0x90)
+      return readArray(variant, code & 0x0F, filter, nestingLimit);
+
+    if ((code & 0xf0) == 0x80)
+      return readObject(variant, code & 0x0F, filter, nestingLimit);
+
+    switch (code) {
+      case 0xdc:
+        return readArray<uint16_t>(variant, filter, nestingLimit);
+
+      case 0xdd:
+        return readArray<uint32_t>(variant, filter, nestingLimit);
+
+      case 0xde:
+        return readObject<uint16_t>(variant, filter, nestingLimit);
+
+      case 0xdf:
+        return readObject<uint32_t>(variant, filter, nestingLimit);
+
+      default:
+        if (filter.allowValue())
+          return parseValue(variant, code);
+        else
+          return skipValue(code);
+    }
+  }
+
+  DeserializationError skipVariant(NestingLimit nestingLimit) {
+    uint8_t code;
+    if (!readByte(code))
+      return DeserializationError::IncompleteInput;
+
+    if ((code & 0xf0) == 0x90)
+      return skipArray(code & 0x0F, nestingLimit);
+
+    if ((code & 0xf0) == 0x80)
+      return skipObject(code & 0x0F, nestingLimit);
+
+    switch (code) {
+      case 0xdc:
+        return skipArray<uint16_t>(nestingLimit);
+
+      case 0xdd:
+        return skipArray<uint32_t>(nestingLimit);
+
+      case 0xde:
+        return skipObject<uint16_t>(nestingLimit);
+
+      case 0xdf:
+        return skipObject<uint32_t>(nestingLimit);
+
+      default:
+        return skipValue(code);
+    }
+  }
+
+  // Parses a value that is neither an array nor a map
+  DeserializationError parseValue(VariantData &variant, uint8_t code) {
     if ((code & 0x80) == 0) {
       variant.setUnsignedInteger(code);
       return DeserializationError::Ok;
@@ -49,14 +110,6 @@ class MsgPackDeserializer {
       return readString(variant, code & 0x1f);
     }
 
-    if ((code & 0xf0) == 0x90) {
-      return readArray(variant.toArray(), code & 0x0F, nestingLimit);
-    }
-
-    if ((code & 0xf0) == 0x80) {
-      return readObject(variant.toObject(), code & 0x0F, nestingLimit);
-    }
-
     switch (code) {
       case 0xc0:
         // already null
@@ -70,6 +123,24 @@ class MsgPackDeserializer {
         variant.setBoolean(true);
         return DeserializationError::Ok;
 
+      case 0xc4:
+        return readBinary<uint8_t>(variant);
+
+      case 0xc5:
+        return readBinary<uint16_t>(variant);
+
+      case 0xc6:
+        return readBinary<uint32_t>(variant);
+
+      case 0xc7:
+        return readExtension<uint8_t>(variant);
+
+      case 0xc8:
+        return readExtension<uint16_t>(variant);
+
+      case 0xc9:
+        return readExtension<uint32_t>(variant);
+
       case 0xcc:
         return readInteger<uint8_t>(variant);
 
@@ -108,6 +179,21 @@ class MsgPackDeserializer {
       case 0xcb:
         return readDouble<double>(variant);
 
+      case 0xd4:
+        return readExtension(variant, 1);
+
+      case 0xd5:
+        return readExtension(variant, 2);
+
+      case 0xd6:
+        return readExtension(variant, 4);
+
+      case 0xd7:
+        return readExtension(variant, 8);
+
+      case 0xd8:
+        return readExtension(variant, 16);
+
       case 0xd9:
         return readString<uint8_t>(variant);
 
@@ -117,26 +203,101 @@ class MsgPackDeserializer {
       case 0xdb:
         return readString<uint32_t>(variant);
 
-      case 0xdc:
-        return readArray<uint16_t>(variant.toArray(), nestingLimit);
+      default:
+        return DeserializationError::NotSupported;
+    }
+  }
 
-      case 0xdd:
-        return readArray<uint32_t>(variant.toArray(), nestingLimit);
+  // Skips a value that is neither an array nor a map, using its length
+  DeserializationError skipValue(uint8_t code) {
+    if ((code & 0x80) == 0 || (code & 0xe0) == 0xe0)
+      return DeserializationError::Ok;  // fixint
 
-      case 0xde:
-        return readObject<uint16_t>(variant.toObject(), nestingLimit);
+    if ((code & 0xe0) == 0xa0)
+      return skipBytes(code & 0x1f);  // fixstr
 
-      case 0xdf:
-        return readObject<uint32_t>(variant.toObject(), nestingLimit);
+    switch (code) {
+      case 0xc0:
+      case 0xc2:
+      case 0xc3:
+        return DeserializationError::Ok;
+
+      case 0xcc:
+      case 0xd0:
+        return skipBytes(1);
+
+      case 0xcd:
+      case 0xd1:
+        return skipBytes(2);
+
+      case 0xca:
+      case 0xce:
+      case 0xd2:
+        return skipBytes(4);
+
+      case 0xcb:
+      case 0xcf:
+      case 0xd3:
+        return skipBytes(8);
+
+      case 0xd4:
+        return skipBytes(2);
+
+      case 0xd5:
+        return skipBytes(3);
+
+      case 0xd6:
+        return skipBytes(5);
+
+      case 0xd7:
+        return skipBytes(9);
+
+      case 0xd8:
+        return skipBytes(17);
+
+      case 0xc4:
+      case 0xd9:
+        return skipBytes<uint8_t>();
+
+      case 0xc5:
+      case 0xda:
+        return skipBytes<uint16_t>();
+
+      case 0xc6:
+      case 0xdb:
+        return skipBytes<uint32_t>();
+
+      case 0xc7:
+        return skipBytes<uint8_t>(1);  // + type
+
+      case 0xc8:
+        return skipBytes<uint16_t>(1);  // + type
+
+      case 0xc9:
+        return skipBytes<uint32_t>(1);  // + type
 
       default:
         return DeserializationError::NotSupported;
     }
   }
 
- private:
-  // Prevent VS warning "assignment operator could not be generated"
-  MsgPackDeserializer &operator=(const MsgPackDeserializer &);
+  // Skips a block of bytes preceded by its length
+  template <typename T>
+  DeserializationError skipBytes(size_t extra = 0) {
+    T size;
+    if (!readInteger(size))
+      return DeserializationError::IncompleteInput;
+    // the input can't be that long, and size + extra would wrap
+    if (size_t(size) > size_t(-1) - extra)
+      return DeserializationError::IncompleteInput;
+    return skipBytes(size + extra);
+  }
+
+  DeserializationError skipBytes(size_t n) {
+    if (_reader.skip(n) != n)
+      return DeserializationError::IncompleteInput;
+    return DeserializationError::Ok;
+  }
 
   bool readByte(uint8_t &value) {
     int c = _reader.read();
@@ -233,47 +394,151 @@ class MsgPackDeserializer {
   }
 
   DeserializationError readString(VariantData &variant, size_t n) {
+    return readString(variant, n, _stringStorage);
+  }
+
+  template <typename TStorage>
+  DeserializationError readString(VariantData &variant, size_t n,
+                                  TStorage &) {
     const char *s = 0;  // <- mute "maybe-uninitialized" (+4 bytes on AVR)
     DeserializationError err = readString(s, n);
     if (!err)
-      variant.setOwnedString(make_not_null(s));
+      _stringStorage.setString(variant, s);
     return err;
   }
 
+  // linkedInput(): the value points to the chars in the input
+  DeserializationError readString(VariantData &variant, size_t n,
+                                  StringLinker &) {
+    const char *s = _reader.link(n);
+    if (!s)
+      return DeserializationError::IncompleteInput;
+    variant.setLinkedString(s, n);
+    return DeserializationError::Ok;
+  }
+
   DeserializationError readString(const char *&result, size_t n) {
-    StringBuilder builder = _stringStorage.startString();
-    for (; n; --n) {
-      uint8_t c;
-      if (!readBytes(c))
-        return DeserializationError::IncompleteInput;
-      builder.append(static_cast<char>(c));
+    // the size is known, so we read the chars straight into the string
+    char *s = _stringStorage.allocString(n);
+    if (!s)
+      return DeserializationError::NoMemory;
+    if (!readBytes(reinterpret_cast<uint8_t *>(s), n)) {
+      _stringStorage.reclaim(s);
+      return DeserializationError::IncompleteInput;
     }
-    result = builder.complete();
-    if (!result)
+    s[n] = 0;
+    _stringStorage.truncate(s, n);
+    result = s;
+    return DeserializationError::Ok;
+  }
+
+  template <typename T>
+  DeserializationError readBinary(VariantData &variant) {
+    T size;
+    if (!readInteger(size))
+      return DeserializationError::IncompleteInput;
+    return readBinary(variant, size, _stringStorage);
+  }
+
+  template <typename TStorage>
+  DeserializationError readBinary(VariantData &variant, size_t n,
+                                  TStorage &) {
+    char *p = 0;
+    DeserializationError err = readInPool(p, n);
+    if (!err)
+      variant.setOwnedBinary(p, n);
+    return err;
+  }
+
+  // linkedInput(): the value points to the bytes in the input
+  DeserializationError readBinary(VariantData &variant, size_t n,
+                                  StringLinker &) {
+    const char *p = _reader.link(n);
+    if (!p)
+      return DeserializationError::IncompleteInput;
+    variant.setLinkedBinary(p, n);
+    return DeserializationError::Ok;
+  }
+
+  template <typename T>
+  DeserializationError readExtension(VariantData &variant) {
+    T size;
+    if (!readInteger(size))
+      return DeserializationError::IncompleteInput;
+    return readExtension(variant, size);
+  }
+
+  DeserializationError readExtension(VariantData &variant, size_t n) {
+    // the type byte is stored with the data, so n + 1 must not wrap
+    if (n == size_t(-1))
+      return DeserializationError::NoMemory;
+    return readExtension(variant, n + 1, _stringStorage);
+  }
+
+  template <typename TStorage>
+  DeserializationError readExtension(VariantData &variant, size_t n,
+                                     TStorage &) {
+    char *p = 0;
+    DeserializationError err = readInPool(p, n);
+    if (!err)
+      variant.setOwnedExtension(p, n);
+    return err;
+  }
+
+  // linkedInput(): the value points to the bytes in the input
+  DeserializationError readExtension(VariantData &variant, size_t n,
+                                     StringLinker &) {
+    const char *p = _reader.link(n);
+    if (!p)
+      return DeserializationError::IncompleteInput;
+    variant.setLinkedExtension(p, n);
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError readInPool(char *&result, size_t n) {
+    char *p = _pool->allocFrozenString(n);
+    if (!p)
       return DeserializationError::NoMemory;
+    if (!readBytes(reinterpret_cast<uint8_t *>(p), n)) {
+      _pool->reclaimLastString(p);
+      return DeserializationError::IncompleteInput;
+    }
+    result = p;
     return DeserializationError::Ok;
   }
 
-  template <typename TSize>
-  DeserializationError readArray(CollectionData &array,
+  template <typename TSize, typename TFilter>
+  DeserializationError readArray(VariantData &variant, TFilter filter,
                                  NestingLimit nestingLimit) {
     TSize size;
     if (!readInteger(size))
       return DeserializationError::IncompleteInput;
-    return readArray(array, size, nestingLimit);
+    return readArray(variant, size, filter, nestingLimit);
   }
 
-  DeserializationError readArray(CollectionData &array, size_t n,
-                                 NestingLimit nestingLimit) {
+  template <typename TFilter>
+  DeserializationError readArray(VariantData &variant, size_t n,
+                                 TFilter filter, NestingLimit nestingLimit) {
+    if (!filter.allowArray())
+      return skipArray(n, nestingLimit);
+
     if (nestingLimit.reached())
       return DeserializationError::TooDeep;
 
-    for (; n; --n) {
-      VariantData *value = array.addElement(_pool);
-      if (!value)
-        return DeserializationError::NoMemory;
+    CollectionData &array = variant.toArray();
+    TFilter memberFilter = filter[0UL];
 
-      DeserializationError err = parse(*value, nestingLimit.decrement());
+    for (; n; --n) {
+      DeserializationError err;
+      if (memberFilter.allow()) {
+        VariantData *value = array.addElement(_pool);
+        if (!value)
+          return DeserializationError::NoMemory;
+
+        err = parseVariant(*value, memberFilter, nestingLimit.decrement());
+      } else {
+        err = skipVariant(nestingLimit.decrement());
+      }
       if (err)
         return err;
     }
@@ -282,31 +547,92 @@ class MsgPackDeserializer {
   }
 
   template <typename TSize>
-  DeserializationError readObject(CollectionData &object,
-                                  NestingLimit nestingLimit) {
+  DeserializationError skipArray(NestingLimit nestingLimit) {
     TSize size;
     if (!readInteger(size))
       return DeserializationError::IncompleteInput;
-    return readObject(object, size, nestingLimit);
+    return skipArray(size, nestingLimit);
   }
 
-  DeserializationError readObject(CollectionData &object, size_t n,
-                                  NestingLimit nestingLimit) {
+  DeserializationError skipArray(size_t n, NestingLimit nestingLimit) {
     if (nestingLimit.reached())
       return DeserializationError::TooDeep;
 
     for (; n; --n) {
-      VariantSlot *slot = object.addSlot(_pool);
-      if (!slot)
-        return DeserializationError::NoMemory;
+      DeserializationError err = skipVariant(nestingLimit.decrement());
+      if (err)
+        return err;
+    }
+
+    return DeserializationError::Ok;
+  }
+
+  template <typename TSize, typename TFilter>
+  DeserializationError readObject(VariantData &variant, TFilter filter,
+                                  NestingLimit nestingLimit) {
+    TSize size;
+    if (!readInteger(size))
+      return DeserializationError::IncompleteInput;
+    return readObject(variant, size, filter, nestingLimit);
+  }
+
+  template <typename TFilter>
+  DeserializationError readObject(VariantData &variant, size_t n,
+                                  TFilter filter, NestingLimit nestingLimit) {
+    if (!filter.allowObject())
+      return skipObject(n, nestingLimit);
 
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    CollectionData &object = variant.toObject();
+
+    for (; n; --n) {
       const char *key = 0;  // <- mute "maybe-uninitialized" (+4 bytes on AVR)
       DeserializationError err = parseKey(key);
       if (err)
         return err;
-      slot->setOwnedKey(make_not_null(key));
 
-      err = parse(*slot->data(), nestingLimit.decrement());
+      TFilter memberFilter = filter[key];
+
+      if (memberFilter.allow()) {
+        VariantSlot *slot = object.addSlot(_pool);
+        if (!slot)
+          return DeserializationError::NoMemory;
+
+        _stringStorage.setKey(slot, key);
+        object.indexMember(slot, _pool);
+
+        err = parseVariant(*slot->data(), memberFilter,
+                           nestingLimit.decrement());
+      } else {
+        _stringStorage.reclaim(key);
+        err = skipVariant(nestingLimit.decrement());
+      }
+      if (err)
+        return err;
+    }
+
+    return DeserializationError::Ok;
+  }
+
+  template <typename TSize>
+  DeserializationError skipObject(NestingLimit nestingLimit) {
+    TSize size;
+    if (!readInteger(size))
+      return DeserializationError::IncompleteInput;
+    return skipObject(size, nestingLimit);
+  }
+
+  DeserializationError skipObject(size_t n, NestingLimit nestingLimit) {
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    for (; n; --n) {
+      DeserializationError err = skipVariant(nestingLimit.decrement());
+      if (err)
+        return err;
+      err = skipVariant(nestingLimit.decrement());
       if (err)
         return err;
     }
@@ -342,6 +668,7 @@ class MsgPackDeserializer {
   TStringStorage _stringStorage;
 };
 
+// deserializeMsgPack(JsonDocument&, const std::string&, ...)
 template <typename TInput>
 DeserializationError deserializeMsgPack(
     JsonDocument &doc, const TInput &input,
@@ -349,28 +676,82 @@ DeserializationError deserializeMsgPack(
   return deserialize<MsgPackDeserializer>(doc, input, nestingLimit,
                                           AllowAllFilter());
 }
+template <typename TInput>
+DeserializationError deserializeMsgPack(
+    JsonDocument &doc, const TInput &input, Filter filter,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<MsgPackDeserializer>(doc, input, nestingLimit, filter);
+}
+template <typename TInput>
+DeserializationError deserializeMsgPack(JsonDocument &doc, const TInput &input,
+                                        NestingLimit nestingLimit,
+                                        Filter filter) {
+  return deserialize<MsgPackDeserializer>(doc, input, nestingLimit, filter);
+}
 
+// deserializeMsgPack(JsonDocument&, std::istream&, ...)
 template <typename TInput>
 DeserializationError deserializeMsgPack(
-    JsonDocument &doc, TInput *input,
+    JsonDocument &doc, TInput &input,
     NestingLimit nestingLimit = NestingLimit()) {
   return deserialize<MsgPackDeserializer>(doc, input, nestingLimit,
                                           AllowAllFilter());
 }
-
 template <typename TInput>
 DeserializationError deserializeMsgPack(
-    JsonDocument &doc, TInput *input, size_t inputSize,
+    JsonDocument &doc, TInput &input, Filter filter,
     NestingLimit nestingLimit = NestingLimit()) {
-  return deserialize<MsgPackDeserializer>(doc, input, inputSize, nestingLimit,
-                                          AllowAllFilter());
+  return deserialize<MsgPackDeserializer>(doc, input, nestingLimit, filter);
 }
-
 template <typename TInput>
+DeserializationError deserializeMsgPack(JsonDocument &doc, TInput &input,
+                                        NestingLimit nestingLimit,
+                                        Filter filter) {
+  return deserialize<MsgPackDeserializer>(doc, input, nestingLimit, filter);
+}
+
+// deserializeMsgPack(JsonDocument&, char*, ...)
+template <typename TChar>
 DeserializationError deserializeMsgPack(
-    JsonDocument &doc, TInput &input,
+    JsonDocument &doc, TChar *input,
     NestingLimit nestingLimit = NestingLimit()) {
   return deserialize<MsgPackDeserializer>(doc, input, nestingLimit,
                                           AllowAllFilter());
 }
+template <typename TChar>
+DeserializationError deserializeMsgPack(
+    JsonDocument &doc, TChar *input, Filter filter,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<MsgPackDeserializer>(doc, input, nestingLimit, filter);
+}
+template <typename TChar>
+DeserializationError deserializeMsgPack(JsonDocument &doc, TChar *input,
+                                        NestingLimit nestingLimit,
+                                        Filter filter) {
+  return deserialize<MsgPackDeserializer>(doc, input, nestingLimit, filter);
+}
+
+// deserializeMsgPack(JsonDocument&, char*, size_t, ...)
+template <typename TChar>
+DeserializationError deserializeMsgPack(
+    JsonDocument &doc, TChar *input, size_t inputSize,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<MsgPackDeserializer>(doc, input, inputSize, nestingLimit,
+                                          AllowAllFilter());
+}
+template <typename TChar>
+DeserializationError deserializeMsgPack(
+    JsonDocument &doc, TChar *input, size_t inputSize, Filter filter,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<MsgPackDeserializer>(doc, input, inputSize, nestingLimit,
+                                          filter);
+}
+template <typename TChar>
+DeserializationError deserializeMsgPack(JsonDocument &doc, TChar *input,
+                                        size_t inputSize,
+                                        NestingLimit nestingLimit,
+                                        Filter filter) {
+  return deserialize<MsgPackDeserializer>(doc, input, inputSize, nestingLimit,
+                                          filter);
+}
 }  // namespace ARDUINOJSON_NAMESPACE
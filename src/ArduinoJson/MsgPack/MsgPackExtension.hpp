@@ -0,0 +1,42 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // int8_t, uint8_t
+
+#include <ArduinoJson/Namespace.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// A MessagePack ext value: an application-defined type and its bytes.
+// The type -1 is the timestamp extension.
+// VariantRef::set() copies the bytes; VariantRef::as() doesn't.
+class MsgPackExtension {
+ public:
+  MsgPackExtension() : _data(0), _size(0), _type(0) {}
+  MsgPackExtension(int8_t type, const void* data, size_t size)
+      : _data(reinterpret_cast<const uint8_t*>(data)),
+        _size(size),
+        _type(type) {}
+
+  int8_t type() const {
+    return _type;
+  }
+
+  const uint8_t* data() const {
+    return _data;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+ private:
+  const uint8_t* _data;
+  size_t _size;
+  int8_t _type;
+};
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -38,43 +38,16 @@ class MsgPackSerializer {
   }
 
   void visitArray(const CollectionData& array) {
-    size_t n = array.size();
-    if (n < 0x10) {
-      writeByte(uint8_t(0x90 + array.size()));
-    } else if (n < 0x10000) {
-      writeByte(0xDC);
-      writeInteger(uint16_t(n));
-    } else {
-      writeByte(0xDD);
-      writeInteger(uint32_t(n));
-    }
-    for (VariantSlot* slot = array.head(); slot; slot = slot->next()) {
-      slot->data()->accept(*this);
-    }
+    writeCollection(array, 0x90, 0xDC, 0xDD);
   }
 
   void visitObject(const CollectionData& object) {
-    size_t n = object.size();
-    if (n < 0x10) {
-      writeByte(uint8_t(0x80 + n));
-    } else if (n < 0x10000) {
-      writeByte(0xDE);
-      writeInteger(uint16_t(n));
-    } else {
-      writeByte(0xDF);
-      writeInteger(uint32_t(n));
-    }
-    for (VariantSlot* slot = object.head(); slot; slot = slot->next()) {
-      visitString(slot->key());
-      slot->data()->accept(*this);
-    }
+    writeCollection(object, 0x80, 0xDE, 0xDF);
   }
 
-  void visitString(const char* value) {
+  void visitString(const char* value, size_t n) {
     ARDUINOJSON_ASSERT(value != NULL);
 
-    size_t n = strlen(value);
-
     if (n < 0x20) {
       writeByte(uint8_t(0xA0 + n));
     } else if (n < 0x100) {
@@ -94,6 +67,54 @@ class MsgPackSerializer {
     writeBytes(reinterpret_cast<const uint8_t*>(data), size);
   }
 
+  void visitBinary(const uint8_t* data, size_t size) {
+    if (size < 0x100) {
+      writeByte(0xC4);
+      writeInteger(uint8_t(size));
+    } else if (size < 0x10000) {
+      writeByte(0xC5);
+      writeInteger(uint16_t(size));
+    } else {
+      writeByte(0xC6);
+      writeInteger(uint32_t(size));
+    }
+    writeBytes(data, size);
+  }
+
+  void visitExtension(int8_t type, const uint8_t* data, size_t size) {
+    switch (size) {
+      case 1:
+        writeByte(0xD4);
+        break;
+      case 2:
+        writeByte(0xD5);
+        break;
+      case 4:
+        writeByte(0xD6);
+        break;
+      case 8:
+        writeByte(0xD7);
+        break;
+      case 16:
+        writeByte(0xD8);
+        break;
+      default:
+        if (size < 0x100) {
+          writeByte(0xC7);
+          writeInteger(uint8_t(size));
+        } else if (size < 0x10000) {
+          writeByte(0xC8);
+          writeInteger(uint16_t(size));
+        } else {
+          writeByte(0xC9);
+          writeInteger(uint32_t(size));
+        }
+        break;
+    }
+    writeInteger(type);
+    writeBytes(data, size);
+  }
+
   void visitNegativeInteger(UInt value) {
     UInt negated = UInt(~value + 1);
     if (value <= 0x20) {
@@ -170,6 +191,76 @@ class MsgPackSerializer {
     writeBytes(reinterpret_cast<uint8_t*>(&value), sizeof(value));
   }
 
+  void writeCollection(const CollectionData& collection, uint8_t fixCode,
+                       uint8_t code16, uint8_t code32) {
+    writeCollection(collection, fixCode, code16, code32, patch_headers());
+  }
+
+  void writeCollection(const CollectionData& collection, uint8_t fixCode,
+                       uint8_t code16, uint8_t code32, false_type) {
+    size_t n = collection.size();
+    if (n < 0x10) {
+      writeByte(uint8_t(fixCode + n));
+    } else if (n < 0x10000) {
+      writeByte(code16);
+      writeInteger(uint16_t(n));
+    } else {
+      writeByte(code32);
+      writeInteger(uint32_t(n));
+    }
+    writeSlots(collection.head());
+  }
+
+  // Writes a one-byte header, then the slots, and then fixes the header.
+  // Unlike size(), this doesn't walk the slots twice.
+  void writeCollection(const CollectionData& collection, uint8_t fixCode,
+                       uint8_t code16, uint8_t code32, true_type) {
+    size_t pos = _writer.tell();
+    size_t headerWritten = _writer.write(fixCode);
+    _bytesWritten += headerWritten;
+    size_t n = writeSlots(collection.head());
+    if (!headerWritten)
+      return;
+    if (n < 0x10) {
+      _writer.patch(pos, uint8_t(fixCode + n));
+      return;
+    }
+    uint8_t size[4];
+    size_t sizeLength;
+    if (n < 0x10000) {
+      _writer.patch(pos, code16);
+      size[0] = uint8_t(n >> 8);
+      size[1] = uint8_t(n);
+      sizeLength = 2;
+    } else {
+      _writer.patch(pos, code32);
+      size[0] = uint8_t(n >> 24);
+      size[1] = uint8_t(n >> 16);
+      size[2] = uint8_t(n >> 8);
+      size[3] = uint8_t(n);
+      sizeLength = 4;
+    }
+    _bytesWritten += _writer.insert(pos + 1, size, sizeLength);
+  }
+
+  // Writes the slots of a collection (with their keys, if any), and returns
+  // how many there are
+  size_t writeSlots(VariantSlot* slot) {
+    size_t n = 0;
+    for (; slot; slot = slot->next()) {
+      if (slot->key())
+        visitString(slot->key(), slot->keyLength());
+      slot->data()->accept(*this);
+      n++;
+    }
+    return n;
+  }
+
+  // With ARDUINOJSON_CACHE_COLLECTION_SIZE, size() runs in constant time
+  typedef integral_constant<bool, IsPatchableWriter<TWriter>::value &&
+                                      !ARDUINOJSON_CACHE_COLLECTION_SIZE>
+      patch_headers;
+
   TWriter _writer;
   size_t _bytesWritten;
 };
@@ -19,13 +19,51 @@
 #define ARDUINOJSON_CONCAT12(A, B, C, D, E, F, G, H, I, J, K, L) \
   ARDUINOJSON_CONCAT8(A, B, C, D, E, F, G,                       \
                       ARDUINOJSON_CONCAT4(H, I, J, ARDUINOJSON_CONCAT2(K, L)))
+#define ARDUINOJSON_CONCAT13(A, B, C, D, E, F, G, H, I, J, K, L, M) \
+  ARDUINOJSON_CONCAT12(A, B, C, D, E, F, G, H, I, J, K,              \
+                       ARDUINOJSON_CONCAT2(L, M))
+#define ARDUINOJSON_CONCAT14(A, B, C, D, E, F, G, H, I, J, K, L, M, N) \
+  ARDUINOJSON_CONCAT13(A, B, C, D, E, F, G, H, I, J, K, L,              \
+                       ARDUINOJSON_CONCAT2(M, N))
+#define ARDUINOJSON_CONCAT15(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O) \
+  ARDUINOJSON_CONCAT14(A, B, C, D, E, F, G, H, I, J, K, L, M,              \
+                       ARDUINOJSON_CONCAT2(N, O))
+#define ARDUINOJSON_CONCAT17(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, \
+                             Q)                                                \
+  ARDUINOJSON_CONCAT15(A, B, C, D, E, F, G, H, I, J, K, L, M, N,               \
+                       ARDUINOJSON_CONCAT2(O, ARDUINOJSON_CONCAT2(P, Q)))
+#define ARDUINOJSON_CONCAT18(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, \
+                             Q, R)                                             \
+  ARDUINOJSON_CONCAT17(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P,         \
+                       ARDUINOJSON_CONCAT2(Q, R))
+#define ARDUINOJSON_CONCAT19(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, \
+                             Q, R, S)                                          \
+  ARDUINOJSON_CONCAT18(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q,      \
+                       ARDUINOJSON_CONCAT2(R, S))
+#define ARDUINOJSON_CONCAT20(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, \
+                             Q, R, S, T)                                       \
+  ARDUINOJSON_CONCAT19(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R,   \
+                       ARDUINOJSON_CONCAT2(S, T))
+#define ARDUINOJSON_CONCAT21(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, \
+                             Q, R, S, T, U)                                    \
+  ARDUINOJSON_CONCAT20(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R,   \
+                       S, ARDUINOJSON_CONCAT2(T, U))
+#define ARDUINOJSON_CONCAT22(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, \
+                             Q, R, S, T, U, V)                                 \
+  ARDUINOJSON_CONCAT21(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R,   \
+                       S, T, ARDUINOJSON_CONCAT2(U, V))
 
-#define ARDUINOJSON_NAMESPACE                                            \
-  ARDUINOJSON_CONCAT12(                                                  \
-      ArduinoJson, ARDUINOJSON_VERSION_MAJOR, ARDUINOJSON_VERSION_MINOR, \
-      ARDUINOJSON_VERSION_REVISION, _, ARDUINOJSON_USE_LONG_LONG,        \
-      ARDUINOJSON_USE_DOUBLE, ARDUINOJSON_DECODE_UNICODE,                \
-      ARDUINOJSON_ENABLE_NAN, ARDUINOJSON_ENABLE_INFINITY,               \
-      ARDUINOJSON_ENABLE_PROGMEM, ARDUINOJSON_ENABLE_COMMENTS)
+#define ARDUINOJSON_NAMESPACE                                               \
+  ARDUINOJSON_CONCAT22(                                                     \
+      ArduinoJson, ARDUINOJSON_VERSION_MAJOR, ARDUINOJSON_VERSION_MINOR,    \
+      ARDUINOJSON_VERSION_REVISION, _, ARDUINOJSON_USE_LONG_LONG,           \
+      ARDUINOJSON_USE_DOUBLE, ARDUINOJSON_DECODE_UNICODE,                   \
+      ARDUINOJSON_ENABLE_NAN, ARDUINOJSON_ENABLE_INFINITY,                  \
+      ARDUINOJSON_ENABLE_PROGMEM, ARDUINOJSON_ENABLE_COMMENTS,              \
+      ARDUINOJSON_ENABLE_STRUCTURAL_INDEX, ARDUINOJSON_ENABLE_OBJECT_INDEX, \
+      ARDUINOJSON_ENABLE_DENSE_ARRAYS, ARDUINOJSON_CACHE_COLLECTION_SIZE,   \
+      ARDUINOJSON_ENABLE_PREVIOUS_LINKS, ARDUINOJSON_ENABLE_GROWABLE_POOL,  \
+      ARDUINOJSON_ENABLE_STRING_DEDUP, ARDUINOJSON_STORE_STRING_LENGTH,     \
+      ARDUINOJSON_ENABLE_FREE_LISTS, ARDUINOJSON_ENABLE_INCREMENTAL_GC)
 
 #endif
@@ -33,10 +33,11 @@ inline VariantData *objectGetMember(const CollectionData *obj,
 }
 
 template <typename TAdaptedString>
-void objectRemove(CollectionData *obj, TAdaptedString key) {
+void objectRemove(CollectionData *obj, TAdaptedString key,
+                  MemoryPool *pool) {
   if (!obj)
     return;
-  obj->removeMember(key);
+  obj->removeMember(key, pool);
 }
 
 template <typename TAdaptedString>
@@ -173,6 +173,7 @@ class ObjectRef : public ObjectRefBase<CollectionData>,
   FORCE_INLINE bool set(ObjectConstRef src) {
     if (!_data || !src._data)
       return false;
+    StringDedupScope dedup(*_pool);
     return _data->copyFrom(*src._data, _pool);
   }
 
@@ -215,14 +216,14 @@ class ObjectRef : public ObjectRefBase<CollectionData>,
   FORCE_INLINE void remove(iterator it) const {
     if (!_data)
       return;
-    _data->removeSlot(it.internal());
+    _data->removeSlot(it.internal(), _pool);
   }
 
   // remove(const std::string&) const
   // remove(const String&) const
   template <typename TString>
   FORCE_INLINE void remove(const TString& key) const {
-    objectRemove(_data, adaptString(key));
+    objectRemove(_data, adaptString(key), _pool);
   }
 
   // remove(char*) const
@@ -230,7 +231,7 @@ class ObjectRef : public ObjectRefBase<CollectionData>,
   // remove(const __FlashStringHelper*) const
   template <typename TChar>
   FORCE_INLINE void remove(TChar* key) const {
-    objectRemove(_data, adaptString(key));
+    objectRemove(_data, adaptString(key), _pool);
   }
 
  private:
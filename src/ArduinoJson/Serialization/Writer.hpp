@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
 
 namespace ARDUINOJSON_NAMESPACE {
 
@@ -26,6 +27,14 @@ class Writer {
   TDestination* _dest;
 };
 
+// A writer that can modify the bytes it already wrote, with these functions:
+//   size_t tell() const;
+//   void patch(size_t pos, uint8_t c);
+//   size_t insert(size_t pos, const uint8_t* s, size_t n);
+// (see MsgPackSerializer)
+template <typename TWriter, typename Enable = void>
+struct IsPatchableWriter : false_type {};
+
 }  // namespace ARDUINOJSON_NAMESPACE
 
 #include <ArduinoJson/Serialization/Writers/StaticStringWriter.hpp>
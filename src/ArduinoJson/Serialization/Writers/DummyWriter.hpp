@@ -4,7 +4,7 @@
 
 #pragma once
 
-#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Serialization/Writer.hpp>
 
 namespace ARDUINOJSON_NAMESPACE {
 
@@ -17,5 +17,18 @@ class DummyWriter {
   size_t write(const uint8_t*, size_t n) {
     return n;
   }
+
+  size_t tell() const {
+    return 0;
+  }
+
+  void patch(size_t, uint8_t) {}
+
+  size_t insert(size_t, const uint8_t*, size_t n) {
+    return n;
+  }
 };
+
+template <>
+struct IsPatchableWriter<DummyWriter> : true_type {};
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -4,14 +4,17 @@
 
 #pragma once
 
-#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Serialization/Writer.hpp>
+
+#include <string.h>  // memcpy, memmove
 
 namespace ARDUINOJSON_NAMESPACE {
 
 // A Print implementation that allows to write in a char[]
 class StaticStringWriter {
  public:
-  StaticStringWriter(char *buf, size_t size) : end(buf + size - 1), p(buf) {
+  StaticStringWriter(char *buf, size_t size)
+      : begin(buf), end(buf + size - 1), p(buf) {
     *p = '\0';
   }
 
@@ -24,17 +27,44 @@ class StaticStringWriter {
   }
 
   size_t write(const uint8_t *s, size_t n) {
-    char *begin = p;
+    char *start = p;
     while (p < end && n > 0) {
       *p++ = static_cast<char>(*s++);
       n--;
     }
     *p = '\0';
+    return size_t(p - start);
+  }
+
+  size_t tell() const {
     return size_t(p - begin);
   }
 
+  void patch(size_t pos, uint8_t c) {
+    begin[pos] = static_cast<char>(c);
+  }
+
+  // Inserts n bytes at pos, shifting the following bytes to the right.
+  // The bytes that get past the end of the buffer are lost.
+  size_t insert(size_t pos, const uint8_t *s, size_t n) {
+    char *at = begin + pos;
+    if (n > size_t(end - at))
+      n = size_t(end - at);
+    char *newEnd = size_t(end - p) < n ? end : p + n;
+    memmove(at + n, at, size_t(newEnd - at) - n);
+    memcpy(at, s, n);
+    size_t inserted = size_t(newEnd - p);
+    p = newEnd;
+    *p = '\0';
+    return inserted;
+  }
+
  private:
+  char *begin;
   char *end;
   char *p;
 };
+
+template <>
+struct IsPatchableWriter<StaticStringWriter> : true_type {};
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -34,7 +34,26 @@ class Writer<TDestination,
     return n;
   }
 
+  size_t tell() const {
+    return _str->size();
+  }
+
+  void patch(size_t pos, uint8_t c) {
+    (*_str)[pos] = static_cast<char>(c);
+  }
+
+  size_t insert(size_t pos, const uint8_t *s, size_t n) {
+    _str->insert(pos, reinterpret_cast<const char *>(s), n);
+    return n;
+  }
+
  private:
   TDestination *_str;
 };
+
+template <typename TDestination>
+struct IsPatchableWriter<
+    Writer<TDestination>,
+    typename enable_if<is_std_string<TDestination>::value>::type>
+    : true_type {};
 }  // namespace ARDUINOJSON_NAMESPACE
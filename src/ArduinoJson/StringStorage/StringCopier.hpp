@@ -6,6 +6,7 @@
 
 #include <ArduinoJson/Memory/MemoryPool.hpp>
 #include <ArduinoJson/Memory/StringBuilder.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
 
 namespace ARDUINOJSON_NAMESPACE {
 
@@ -19,10 +20,40 @@ class StringCopier {
     return StringBuilder(_pool);
   }
 
+  // Allocates a string of n chars, plus the terminator that the caller must
+  // write. Returns NULL if the pool is full.
+  char* allocString(size_t n) {
+    if (n == size_t(-1))  // no room for the terminator
+      return 0;
+    return _pool->allocFrozenString(n + 1);
+  }
+
+  // Completes a string from allocString(), which may contain NULs
+  void truncate(char* s, size_t n) {
+    truncateStoredLength(s, n);
+  }
+
   void reclaim(const char* s) {
     _pool->reclaimLastString(s);
   }
 
+  const char* deduplicate(const char* s) {
+    return _pool->deduplicate(s);
+  }
+
+  void setString(VariantData& variant, const char* s) {
+    variant.setOwnedString(make_not_null(deduplicate(s)));
+  }
+
+  void setKey(VariantSlot* slot, const char* s) {
+    slot->setOwnedKey(make_not_null(deduplicate(s)));
+  }
+
+  // Gets the number of bytes that a string takes in the MemoryPool
+  static size_t poolSize(size_t length) {
+    return MemoryPool::stringBlockSize(length + 1);
+  }
+
  private:
   MemoryPool* _pool;
 };
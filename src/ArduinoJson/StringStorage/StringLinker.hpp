@@ -0,0 +1,17 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/StringStorage/StringCopier.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Stores the strings like StringCopier, but lets MsgPackDeserializer link the
+// string values to the input (see linkedInput())
+class StringLinker : public StringCopier {
+ public:
+  StringLinker(MemoryPool* pool) : StringCopier(pool) {}
+};
+}  // namespace ARDUINOJSON_NAMESPACE
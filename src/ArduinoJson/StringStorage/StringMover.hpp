@@ -4,7 +4,9 @@
 
 #pragma once
 
-#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+#include <string.h>  // memmove
 
 namespace ARDUINOJSON_NAMESPACE {
 
@@ -18,6 +20,12 @@ class StringMover {
       *(*_writePtr)++ = char(c);
     }
 
+    // the source and the destination can overlap since we write in the input
+    void append(const char* s, size_t n) {
+      memmove(*_writePtr, s, n);
+      *_writePtr += n;
+    }
+
     char* complete() const {
       *(*_writePtr)++ = 0;
       return _startPtr;
@@ -34,11 +42,51 @@ class StringMover {
     return StringBuilder(&_ptr);
   }
 
+  // Allocates a string of n chars, plus the terminator that the caller must
+  // write after reading the chars, which may overlap
+  char* allocString(size_t n) {
+    char* s = _ptr;
+    _ptr += n + 1;
+    return s;
+  }
+
+  // the strings have no length header, there is nothing to update
+  void truncate(char*, size_t) {}
+
   // recover memory from last string
   void reclaim(const char* str) {
     _ptr = const_cast<char*>(str);
   }
 
+  // the strings stay in the input, there is nothing to save
+  const char* deduplicate(const char* s) {
+    return s;
+  }
+
+#if ARDUINOJSON_STORE_STRING_LENGTH
+  // the strings have no length header, so they can't be owned
+  void setString(VariantData& variant, const char* s) {
+    variant.setLinkedString(s);
+  }
+
+  void setKey(VariantSlot* slot, const char* s) {
+    slot->setLinkedKey(make_not_null(s));
+  }
+#else
+  void setString(VariantData& variant, const char* s) {
+    variant.setOwnedString(make_not_null(s));
+  }
+
+  void setKey(VariantSlot* slot, const char* s) {
+    slot->setOwnedKey(make_not_null(s));
+  }
+#endif
+
+  // the strings stay in the input
+  static size_t poolSize(size_t) {
+    return 0;
+  }
+
  private:
   char* _ptr;
 };
@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <ArduinoJson/Deserialization/Reader.hpp>
 #include <ArduinoJson/StringStorage/StringCopier.hpp>
+#include <ArduinoJson/StringStorage/StringLinker.hpp>
 #include <ArduinoJson/StringStorage/StringMover.hpp>
 
 namespace ARDUINOJSON_NAMESPACE {
@@ -28,6 +30,17 @@ struct StringStorage<TChar*,
   }
 };
 
+template <typename TInput>
+struct StringStorage<TInput, typename enable_if<is_same<
+                                 typename remove_const<TInput>::type,
+                                 LinkedInput>::value>::type> {
+  typedef StringLinker type;
+
+  static type create(MemoryPool& pool, TInput&) {
+    return type(&pool);
+  }
+};
+
 template <typename TInput>
 typename StringStorage<TInput>::type makeStringStorage(MemoryPool& pool,
                                                        TInput& input) {
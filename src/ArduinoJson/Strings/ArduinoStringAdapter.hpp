@@ -21,8 +21,10 @@ class ArduinoStringAdapter {
       return NULL;
     size_t n = _str->length() + 1;
     char* dup = pool->allocFrozenString(n);
-    if (dup)
+    if (dup) {
       memcpy(dup, _str->c_str(), n);
+      truncateStoredLength(dup, n - 1);
+    }
     return dup;
   }
 
@@ -45,6 +47,10 @@ class ArduinoStringAdapter {
     return _str->length();
   }
 
+  char operator[](size_t i) const {
+    return _str->c_str()[i];
+  }
+
   typedef storage_policy::store_by_copy storage_policy;
 
  private:
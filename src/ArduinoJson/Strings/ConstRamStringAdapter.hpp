@@ -35,6 +35,10 @@ class ConstRamStringAdapter {
     return strlen(_str);
   }
 
+  char operator[](size_t i) const {
+    return _str[i];
+  }
+
   const char* data() const {
     return _str;
   }
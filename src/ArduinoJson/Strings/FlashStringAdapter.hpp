@@ -49,6 +49,11 @@ class FlashStringAdapter {
     return strlen_P(reinterpret_cast<const char*>(_str));
   }
 
+  char operator[](size_t i) const {
+    return static_cast<char>(
+        pgm_read_byte(reinterpret_cast<const char*>(_str) + i));
+  }
+
   typedef storage_policy::store_by_copy storage_policy;
 
  private:
@@ -41,6 +41,10 @@ class SizedRamStringAdapter {
     return _size;
   }
 
+  char operator[](size_t i) const {
+    return _str[i];
+  }
+
   typedef storage_policy::store_by_copy storage_policy;
 
  private:
@@ -21,8 +21,10 @@ class StlStringAdapter {
   char* save(MemoryPool* pool) const {
     size_t n = _str->length() + 1;
     char* dup = pool->allocFrozenString(n);
-    if (dup)
+    if (dup) {
       memcpy(dup, _str->c_str(), n);
+      truncateStoredLength(dup, n - 1);
+    }
     return dup;
   }
 
@@ -46,6 +48,10 @@ class StlStringAdapter {
     return _str->size();
   }
 
+  char operator[](size_t i) const {
+    return (*_str)[i];
+  }
+
   typedef storage_policy::store_by_copy storage_policy;
 
  private:
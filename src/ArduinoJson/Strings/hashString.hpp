@@ -0,0 +1,26 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint8_t, uint32_t
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// FNV-1a
+template <typename TAdaptedString>
+inline uint32_t hashString(const TAdaptedString& str) {
+  uint32_t hash = 2166136261u;
+  size_t n = str.size();
+  for (size_t i = 0; i < n; i++) {
+    hash ^= static_cast<uint8_t>(str[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -37,7 +37,7 @@ inline bool slotSetKey(VariantSlot* var, TAdaptedString key, MemoryPool*,
 template <typename TAdaptedString>
 inline bool slotSetKey(VariantSlot* var, TAdaptedString key, MemoryPool* pool,
                        storage_policy::store_by_copy) {
-  const char* dup = key.save(pool);
+  const char* dup = pool->deduplicate(key.save(pool));
   if (!dup)
     return false;
   ARDUINOJSON_ASSERT(var);
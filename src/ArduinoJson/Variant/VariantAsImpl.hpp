@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <ArduinoJson/Serialization/Writer.hpp>
 #include <ArduinoJson/Strings/IsWriteableString.hpp>
 #include <ArduinoJson/Variant/VariantFunctions.hpp>
 #include <ArduinoJson/Variant/VariantRef.hpp>
@@ -35,6 +36,13 @@ inline typename enable_if<IsWriteableString<T>::value, T>::type variantAs(
   if (cstr)
     return T(cstr);
   T s;
+  if (_data && _data->isString()) {
+    // a string without terminator
+    RawData value = _data->asSizedString();
+    Writer<T> writer(s);
+    writer.write(reinterpret_cast<const uint8_t*>(value.data), value.size);
+    return s;
+  }
   serializeJson(VariantConstRef(_data), s);
   return s;
 }
@@ -18,6 +18,21 @@ class CollectionData;
 template <typename T, typename Enable = void>
 struct Comparer;
 
+// Compares an adapted string with a string that may not be terminated
+template <typename TAdaptedString>
+int compareString(TAdaptedString s, const char *other, size_t n) {
+  if (s.isNull())
+    return -1;
+  size_t size = s.size();
+  for (size_t i = 0; i < size && i < n; i++) {
+    unsigned char a = static_cast<unsigned char>(s[i]);
+    unsigned char b = static_cast<unsigned char>(other[i]);
+    if (a != b)
+      return a < b ? -1 : 1;
+  }
+  return size < n ? -1 : size > n ? 1 : 0;
+}
+
 template <typename T>
 struct Comparer<T, typename enable_if<IsString<T>::value>::type> {
   T rhs;
@@ -28,10 +43,12 @@ struct Comparer<T, typename enable_if<IsString<T>::value>::type> {
   void visitArray(const CollectionData &) {}
   void visitObject(const CollectionData &) {}
   void visitFloat(Float) {}
-  void visitString(const char *lhs) {
-    result = -adaptString(rhs).compare(lhs);
+  void visitString(const char *lhs, size_t n) {
+    result = -compareString(adaptString(rhs), lhs, n);
   }
   void visitRawJson(const char *, size_t) {}
+  void visitBinary(const uint8_t *, size_t) {}
+  void visitExtension(int8_t, const uint8_t *, size_t) {}
   void visitNegativeInteger(UInt) {}
   void visitPositiveInteger(UInt) {}
   void visitBoolean(bool) {}
@@ -62,8 +79,10 @@ struct Comparer<T, typename enable_if<is_integral<T>::value ||
   void visitFloat(Float lhs) {
     result = sign2(lhs - static_cast<Float>(rhs));
   }
-  void visitString(const char *) {}
+  void visitString(const char *, size_t) {}
   void visitRawJson(const char *, size_t) {}
+  void visitBinary(const uint8_t *, size_t) {}
+  void visitExtension(int8_t, const uint8_t *, size_t) {}
   void visitNegativeInteger(UInt lhs) {
     result = -sign2(static_cast<T>(lhs) + rhs);
   }
@@ -84,8 +103,10 @@ struct Comparer<bool, void> {
   void visitArray(const CollectionData &) {}
   void visitObject(const CollectionData &) {}
   void visitFloat(Float) {}
-  void visitString(const char *) {}
+  void visitString(const char *, size_t) {}
   void visitRawJson(const char *, size_t) {}
+  void visitBinary(const uint8_t *, size_t) {}
+  void visitExtension(int8_t, const uint8_t *, size_t) {}
   void visitNegativeInteger(UInt) {}
   void visitPositiveInteger(UInt) {}
   void visitBoolean(bool lhs) {
@@ -104,8 +125,10 @@ struct Comparer<decltype(nullptr), void> {
   void visitArray(const CollectionData &) {}
   void visitObject(const CollectionData &) {}
   void visitFloat(Float) {}
-  void visitString(const char *) {}
+  void visitString(const char *, size_t) {}
   void visitRawJson(const char *, size_t) {}
+  void visitBinary(const uint8_t *, size_t) {}
+  void visitExtension(int8_t, const uint8_t *, size_t) {}
   void visitNegativeInteger(UInt) {}
   void visitPositiveInteger(UInt) {}
   void visitBoolean(bool) {}
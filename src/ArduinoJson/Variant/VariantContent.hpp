@@ -22,17 +22,32 @@ enum {
   VALUE_IS_OWNED_RAW = 0x03,
   VALUE_IS_LINKED_STRING = 0x04,
   VALUE_IS_OWNED_STRING = 0x05,
+  // MsgPack bin, the bytes are in asRaw
+  VALUE_IS_LINKED_BINARY = 0x12,
+  VALUE_IS_OWNED_BINARY = 0x13,
+  // MsgPack ext, asRaw contains the type byte, then the bytes
+  VALUE_IS_LINKED_EXTENSION = 0x14,
+  VALUE_IS_OWNED_EXTENSION = 0x15,
 
   // CAUTION: no VALUE_IS_OWNED below
   VALUE_IS_BOOLEAN = 0x06,
   VALUE_IS_POSITIVE_INTEGER = 0x08,
   VALUE_IS_NEGATIVE_INTEGER = 0x0A,
   VALUE_IS_FLOAT = 0x0C,
+  // a string in a buffer that outlives the document, without terminator
+  // (the pointer and the size are in asRaw)
+  VALUE_IS_LINKED_SIZED_STRING = 0x0E,
 
   COLLECTION_MASK = 0x60,
   VALUE_IS_OBJECT = 0x20,
   VALUE_IS_ARRAY = 0x40,
 
+  // The garbage collector marks the live slots with both COLLECTION bits,
+  // which no value has, and keeps the type in the other bits
+  // (see VariantSlot::mark())
+  MARKED_OBJECT = 0x1E,
+  MARKED_ARRAY = 0x1F,
+
   KEY_IS_OWNED = 0x80
 };
 
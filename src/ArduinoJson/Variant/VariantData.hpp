@@ -5,6 +5,8 @@
 #pragma once
 
 #include <ArduinoJson/Misc/SerializedValue.hpp>
+#include <ArduinoJson/MsgPack/MsgPackBinary.hpp>
+#include <ArduinoJson/MsgPack/MsgPackExtension.hpp>
 #include <ArduinoJson/Numbers/convertNumber.hpp>
 #include <ArduinoJson/Polyfills/gsl/not_null.hpp>
 #include <ArduinoJson/Strings/RamStringAdapter.hpp>
@@ -46,13 +48,33 @@ class VariantData {
         return visitor.visitObject(_content.asCollection);
 
       case VALUE_IS_LINKED_STRING:
+        return visitor.visitString(_content.asString,
+                                   strlen(_content.asString));
+
       case VALUE_IS_OWNED_STRING:
-        return visitor.visitString(_content.asString);
+        return visitor.visitString(_content.asString,
+                                   storedLength(_content.asString));
+
+      case VALUE_IS_LINKED_SIZED_STRING:
+        return visitor.visitString(_content.asRaw.data, _content.asRaw.size);
 
       case VALUE_IS_OWNED_RAW:
       case VALUE_IS_LINKED_RAW:
         return visitor.visitRawJson(_content.asRaw.data, _content.asRaw.size);
 
+      case VALUE_IS_OWNED_BINARY:
+      case VALUE_IS_LINKED_BINARY:
+        return visitor.visitBinary(
+            reinterpret_cast<const uint8_t *>(_content.asRaw.data),
+            _content.asRaw.size);
+
+      case VALUE_IS_OWNED_EXTENSION:
+      case VALUE_IS_LINKED_EXTENSION:
+        return visitor.visitExtension(
+            static_cast<int8_t>(_content.asRaw.data[0]),
+            reinterpret_cast<const uint8_t *>(_content.asRaw.data + 1),
+            _content.asRaw.size - 1);
+
       case VALUE_IS_NEGATIVE_INTEGER:
         return visitor.visitNegativeInteger(_content.asInteger);
 
@@ -75,6 +97,19 @@ class VariantData {
 
   const char *asString() const;
 
+  MsgPackBinary asBinary() const {
+    if (!isBinary())
+      return MsgPackBinary();
+    return MsgPackBinary(_content.asRaw.data, _content.asRaw.size);
+  }
+
+  MsgPackExtension asExtension() const {
+    if (!isExtension())
+      return MsgPackExtension();
+    return MsgPackExtension(static_cast<int8_t>(_content.asRaw.data[0]),
+                            _content.asRaw.data + 1, _content.asRaw.size - 1);
+  }
+
   bool asBoolean() const;
 
   CollectionData *asArray() {
@@ -108,6 +143,10 @@ class VariantData {
       case VALUE_IS_OWNED_RAW:
         return setOwnedRaw(
             serialized(src._content.asRaw.data, src._content.asRaw.size), pool);
+      case VALUE_IS_OWNED_BINARY:
+        return setOwnedBinary(src.asBinary(), pool);
+      case VALUE_IS_OWNED_EXTENSION:
+        return setOwnedExtension(src.asExtension(), pool);
       default:
         setType(src.type());
         _content = src._content;
@@ -116,6 +155,16 @@ class VariantData {
   }
 
   bool equals(const VariantData &other) const {
+    // A sized string can be equal to any kind of string
+    if (type() == VALUE_IS_LINKED_SIZED_STRING ||
+        other.type() == VALUE_IS_LINKED_SIZED_STRING) {
+      if (!isString() || !other.isString())
+        return false;
+      RawData a = asSizedString();
+      RawData b = other.asSizedString();
+      return a.size == b.size && !memcmp(a.data, b.data, a.size);
+    }
+
     // Check that variant have the same type, but ignore string ownership
     if ((type() | VALUE_IS_OWNED) != (other.type() | VALUE_IS_OWNED))
       return false;
@@ -123,10 +172,21 @@ class VariantData {
     switch (type()) {
       case VALUE_IS_LINKED_STRING:
       case VALUE_IS_OWNED_STRING:
+#if ARDUINOJSON_STORE_STRING_LENGTH
+        if (type() == VALUE_IS_OWNED_STRING &&
+            other.type() == VALUE_IS_OWNED_STRING &&
+            storedLength(_content.asString) !=
+                storedLength(other._content.asString))
+          return false;
+#endif
         return !strcmp(_content.asString, other._content.asString);
 
       case VALUE_IS_LINKED_RAW:
       case VALUE_IS_OWNED_RAW:
+      case VALUE_IS_LINKED_BINARY:
+      case VALUE_IS_OWNED_BINARY:
+      case VALUE_IS_LINKED_EXTENSION:
+      case VALUE_IS_OWNED_EXTENSION:
         return _content.asRaw.size == other._content.asRaw.size &&
                !memcmp(_content.asRaw.data, other._content.asRaw.data,
                        _content.asRaw.size);
@@ -155,6 +215,10 @@ class VariantData {
     return (_flags & VALUE_IS_ARRAY) != 0;
   }
 
+  bool isBinary() const {
+    return type() == VALUE_IS_LINKED_BINARY || type() == VALUE_IS_OWNED_BINARY;
+  }
+
   bool isBoolean() const {
     return type() == VALUE_IS_BOOLEAN;
   }
@@ -177,13 +241,45 @@ class VariantData {
     }
   }
 
+  bool isExtension() const {
+    return type() == VALUE_IS_LINKED_EXTENSION ||
+           type() == VALUE_IS_OWNED_EXTENSION;
+  }
+
   bool isFloat() const {
     return type() == VALUE_IS_FLOAT || type() == VALUE_IS_POSITIVE_INTEGER ||
            type() == VALUE_IS_NEGATIVE_INTEGER;
   }
 
   bool isString() const {
-    return type() == VALUE_IS_LINKED_STRING || type() == VALUE_IS_OWNED_STRING;
+    return type() == VALUE_IS_LINKED_STRING ||
+           type() == VALUE_IS_OWNED_STRING ||
+           type() == VALUE_IS_LINKED_SIZED_STRING;
+  }
+
+  // Gets any kind of string with its size.
+  // Unlike asString(), it works with VALUE_IS_LINKED_SIZED_STRING.
+  RawData asSizedString() const {
+    RawData s;
+    switch (type()) {
+      case VALUE_IS_LINKED_STRING:
+        s.data = _content.asString;
+        s.size = strlen(_content.asString);
+        break;
+      case VALUE_IS_OWNED_STRING:
+        s.data = _content.asString;
+        s.size = storedLength(_content.asString);
+        break;
+      case VALUE_IS_LINKED_SIZED_STRING:
+        s.data = _content.asRaw.data;
+        s.size = _content.asRaw.size;
+        break;
+      default:
+        s.data = 0;
+        s.size = 0;
+        break;
+    }
+    return s;
   }
 
   bool isObject() const {
@@ -198,15 +294,15 @@ class VariantData {
     return !isFloat();
   }
 
-  void remove(size_t index) {
+  void remove(size_t index, MemoryPool *pool) {
     if (isArray())
-      _content.asCollection.removeElement(index);
+      _content.asCollection.removeElement(index, pool);
   }
 
   template <typename TAdaptedString>
-  void remove(TAdaptedString key) {
+  void remove(TAdaptedString key, MemoryPool *pool) {
     if (isObject())
-      _content.asCollection.removeMember(key);
+      _content.asCollection.removeMember(key, pool);
   }
 
   void setBoolean(bool value) {
@@ -243,6 +339,59 @@ class VariantData {
     }
   }
 
+  // The bytes must outlive the document
+  void setLinkedBinary(const char *data, size_t size) {
+    setType(VALUE_IS_LINKED_BINARY);
+    _content.asRaw.data = data;
+    _content.asRaw.size = size;
+  }
+
+  // The bytes must be in the MemoryPool
+  void setOwnedBinary(const char *data, size_t size) {
+    setType(VALUE_IS_OWNED_BINARY);
+    _content.asRaw.data = data;
+    _content.asRaw.size = size;
+  }
+
+  bool setOwnedBinary(MsgPackBinary value, MemoryPool *pool) {
+    char *dup = value.data() ? pool->allocFrozenString(value.size()) : 0;
+    if (!dup) {
+      setType(VALUE_IS_NULL);
+      return false;
+    }
+    memcpy(dup, value.data(), value.size());
+    setOwnedBinary(dup, value.size());
+    return true;
+  }
+
+  // data points to the type byte, followed by the bytes of the extension
+  // The bytes must outlive the document
+  void setLinkedExtension(const char *data, size_t size) {
+    setType(VALUE_IS_LINKED_EXTENSION);
+    _content.asRaw.data = data;
+    _content.asRaw.size = size;
+  }
+
+  // data points to the type byte, followed by the bytes of the extension
+  // The bytes must be in the MemoryPool
+  void setOwnedExtension(const char *data, size_t size) {
+    setType(VALUE_IS_OWNED_EXTENSION);
+    _content.asRaw.data = data;
+    _content.asRaw.size = size;
+  }
+
+  bool setOwnedExtension(MsgPackExtension value, MemoryPool *pool) {
+    char *dup = value.data() ? pool->allocFrozenString(value.size() + 1) : 0;
+    if (!dup) {
+      setType(VALUE_IS_NULL);
+      return false;
+    }
+    dup[0] = static_cast<char>(value.type());
+    memcpy(dup + 1, value.data(), value.size());
+    setOwnedExtension(dup, value.size() + 1);
+    return true;
+  }
+
   template <typename T>
   typename enable_if<is_unsigned<T>::value>::type setInteger(T value) {
     setUnsignedInteger(value);
@@ -286,6 +435,13 @@ class VariantData {
     }
   }
 
+  // The string doesn't need a terminator, but it must outlive the document
+  void setLinkedString(const char *value, size_t size) {
+    setType(VALUE_IS_LINKED_SIZED_STRING);
+    _content.asRaw.data = value;
+    _content.asRaw.size = size;
+  }
+
   void setNull() {
     setType(VALUE_IS_NULL);
   }
@@ -307,7 +463,7 @@ class VariantData {
 
   template <typename T>
   bool setOwnedString(T value, MemoryPool *pool) {
-    return setOwnedString(value.save(pool));
+    return setOwnedString(pool->deduplicate(value.save(pool)));
   }
 
   CollectionData &toArray() {
@@ -325,9 +481,11 @@ class VariantData {
   size_t memoryUsage() const {
     switch (type()) {
       case VALUE_IS_OWNED_STRING:
-        return strlen(_content.asString) + 1;
+        return stringHeaderSize + storedLength(_content.asString) + 1;
       case VALUE_IS_OWNED_RAW:
-        return _content.asRaw.size;
+      case VALUE_IS_OWNED_BINARY:
+      case VALUE_IS_OWNED_EXTENSION:
+        return stringHeaderSize + _content.asRaw.size;
       case VALUE_IS_OBJECT:
       case VALUE_IS_ARRAY:
         return _content.asCollection.memoryUsage();
@@ -336,6 +494,28 @@ class VariantData {
     }
   }
 
+  // Gives the strings and the slots that this value owns back to the pool
+  // (see ARDUINOJSON_ENABLE_FREE_LISTS)
+  void release(MemoryPool *pool) {
+    switch (type()) {
+      case VALUE_IS_OWNED_STRING:
+        pool->freeString(_content.asString,
+                         storedLength(_content.asString) + 1);
+        break;
+      case VALUE_IS_OWNED_RAW:
+      case VALUE_IS_OWNED_BINARY:
+      case VALUE_IS_OWNED_EXTENSION:
+        pool->freeString(_content.asRaw.data, _content.asRaw.size);
+        break;
+      case VALUE_IS_OBJECT:
+      case VALUE_IS_ARRAY:
+        _content.asCollection.release(pool);
+        break;
+      default:
+        break;
+    }
+  }
+
   size_t nesting() const {
     return isCollection() ? _content.asCollection.nesting() : 0;
   }
@@ -385,6 +565,43 @@ class VariantData {
       _content.asCollection.movePointers(stringDistance, variantDistance);
   }
 
+  // The steps of the garbage collector (see JsonDocument::compact())
+
+  void markSlots() {
+    if (isCollection())
+      _content.asCollection.markSlots();
+  }
+
+  void relinkSlots(const MemoryPool *pool) {
+    if (isCollection())
+      _content.asCollection.relinkSlots(pool);
+  }
+
+  template <typename TCollector>
+  void collectStrings(TCollector &collector) {
+    switch (type()) {
+      case VALUE_IS_OWNED_STRING:
+        collector.addString(_content.asString);
+        break;
+      case VALUE_IS_OWNED_RAW:
+      case VALUE_IS_OWNED_BINARY:
+      case VALUE_IS_OWNED_EXTENSION:
+        collector.addString(_content.asRaw.data, _content.asRaw.size);
+        break;
+      case VALUE_IS_OBJECT:
+      case VALUE_IS_ARRAY:
+        _content.asCollection.collectStrings(collector);
+        break;
+      default:
+        break;
+    }
+  }
+
+  void reindexMembers(MemoryPool *pool) {
+    if (isCollection())
+      _content.asCollection.reindexMembers(pool);
+  }
+
   uint8_t flags() {
     return _flags;
   }
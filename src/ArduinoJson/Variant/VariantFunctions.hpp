@@ -37,6 +37,10 @@ inline bool variantCopyFrom(VariantData *dst, const VariantData *src,
     dst->setNull();
     return true;
   }
+  if (src->isCollection()) {
+    StringDedupScope dedup(*pool);
+    return dst->copyFrom(*src, pool);
+  }
   return dst->copyFrom(*src, pool);
 }
 
@@ -52,6 +56,10 @@ inline bool variantIsArray(const VariantData *var) {
   return var && var->isArray();
 }
 
+inline bool variantIsBinary(const VariantData *var) {
+  return var && var->isBinary();
+}
+
 inline bool variantIsBoolean(const VariantData *var) {
   return var && var->isBoolean();
 }
@@ -61,6 +69,10 @@ inline bool variantIsInteger(const VariantData *var) {
   return var && var->isInteger<T>();
 }
 
+inline bool variantIsExtension(const VariantData *var) {
+  return var && var->isExtension();
+}
+
 inline bool variantIsFloat(const VariantData *var) {
   return var && var->isFloat();
 }
@@ -105,6 +117,16 @@ inline bool variantSetOwnedRaw(VariantData *var, SerializedValue<T> value,
   return var != 0 && var->setOwnedRaw(value, pool);
 }
 
+inline bool variantSetOwnedBinary(VariantData *var, MsgPackBinary value,
+                                  MemoryPool *pool) {
+  return var != 0 && var->setOwnedBinary(value, pool);
+}
+
+inline bool variantSetOwnedExtension(VariantData *var, MsgPackExtension value,
+                                     MemoryPool *pool) {
+  return var != 0 && var->setOwnedExtension(value, pool);
+}
+
 inline bool variantSetLinkedString(VariantData *var, const char *value) {
   if (!var)
     return false;
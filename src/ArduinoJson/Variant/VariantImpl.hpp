@@ -66,6 +66,7 @@ inline T VariantData::asFloat() const {
   }
 }
 
+// Returns 0 for VALUE_IS_LINKED_SIZED_STRING because it has no terminator
 inline const char *VariantData::asString() const {
   switch (type()) {
     case VALUE_IS_LINKED_STRING:
@@ -92,6 +92,21 @@ class VariantRefBase {
   is() const {
     return variantIsObject(_data);
   }
+  //
+  // bool is<MsgPackBinary> const;
+  template <typename T>
+  FORCE_INLINE typename enable_if<is_same<T, MsgPackBinary>::value, bool>::type
+  is() const {
+    return variantIsBinary(_data);
+  }
+  //
+  // bool is<MsgPackExtension> const;
+  template <typename T>
+  FORCE_INLINE
+      typename enable_if<is_same<T, MsgPackExtension>::value, bool>::type
+      is() const {
+    return variantIsExtension(_data);
+  }
 #if ARDUINOJSON_HAS_NULLPTR
   //
   // bool is<nullptr_t> const;
@@ -207,6 +222,16 @@ class VariantRef : public VariantRefBase<VariantData>,
     return variantSetOwnedRaw(_data, value, _pool);
   }
 
+  // set(MsgPackBinary)
+  FORCE_INLINE bool set(MsgPackBinary value) const {
+    return variantSetOwnedBinary(_data, value, _pool);
+  }
+
+  // set(MsgPackExtension)
+  FORCE_INLINE bool set(MsgPackExtension value) const {
+    return variantSetOwnedExtension(_data, value, _pool);
+  }
+
   // set(const std::string&)
   // set(const String&)
   template <typename T>
@@ -315,7 +340,7 @@ class VariantRef : public VariantRefBase<VariantData>,
 
   FORCE_INLINE void remove(size_t index) const {
     if (_data)
-      _data->remove(index);
+      _data->remove(index, _pool);
   }
   // remove(char*) const
   // remove(const char*) const
@@ -324,7 +349,7 @@ class VariantRef : public VariantRefBase<VariantData>,
   FORCE_INLINE typename enable_if<IsString<TChar *>::value>::type remove(
       TChar *key) const {
     if (_data)
-      _data->remove(adaptString(key));
+      _data->remove(adaptString(key), _pool);
   }
   // remove(const std::string&) const
   // remove(const String&) const
@@ -332,7 +357,7 @@ class VariantRef : public VariantRefBase<VariantData>,
   FORCE_INLINE typename enable_if<IsString<TString>::value>::type remove(
       const TString &key) const {
     if (_data)
-      _data->remove(adaptString(key));
+      _data->remove(adaptString(key), _pool);
   }
 
  private:
@@ -4,15 +4,22 @@
 
 #pragma once
 
+#include <ArduinoJson/Memory/StringSlot.hpp>
 #include <ArduinoJson/Polyfills/gsl/not_null.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
 #include <ArduinoJson/Variant/VariantContent.hpp>
 
+#include <stddef.h>  // ptrdiff_t
 #include <stdint.h>  // int8_t, int16_t
 
 namespace ARDUINOJSON_NAMESPACE {
 
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+// the slots of a collection can be in chunks that are anywhere in the heap
+typedef ptrdiff_t VariantSlotDiff;
+#else
 typedef conditional<sizeof(void*) <= 2, int8_t, int16_t>::type VariantSlotDiff;
+#endif
 
 class VariantSlot {
   // CAUTION: same layout as VariantData
@@ -21,6 +28,9 @@ class VariantSlot {
   VariantContent _content;
   uint8_t _flags;
   VariantSlotDiff _next;
+#if ARDUINOJSON_ENABLE_PREVIOUS_LINKS
+  VariantSlotDiff _prev;
+#endif
   const char* _key;
 
  public:
@@ -69,6 +79,16 @@ class VariantSlot {
     _next = VariantSlotDiff(slot - this);
   }
 
+#if ARDUINOJSON_ENABLE_PREVIOUS_LINKS
+  VariantSlot* prev() {
+    return _prev ? this + _prev : 0;
+  }
+
+  void setPrev(VariantSlot* slot) {
+    _prev = VariantSlotDiff(slot ? slot - this : 0);
+  }
+#endif
+
   void setOwnedKey(not_null<const char*> k) {
     _flags |= KEY_IS_OWNED;
     _key = k.get();
@@ -91,8 +111,15 @@ class VariantSlot {
     return (_flags & KEY_IS_OWNED) != 0;
   }
 
+  size_t keyLength() const {
+    return ownsKey() ? storedLength(_key) : strlen(_key);
+  }
+
   void clear() {
     _next = 0;
+#if ARDUINOJSON_ENABLE_PREVIOUS_LINKS
+    _prev = 0;
+#endif
     _flags = 0;
     _key = 0;
   }
@@ -105,6 +132,45 @@ class VariantSlot {
     if (_flags & COLLECTION_MASK)
       _content.asCollection.movePointers(stringDistance, variantDistance);
   }
+
+  // Tells whether the garbage collector marked the slot as live
+  bool isMarked() const {
+    return (_flags & COLLECTION_MASK) == COLLECTION_MASK;
+  }
+
+  // CAUTION: a marked slot has no type, until unmark()
+  void mark() {
+    uint8_t type = _flags & VALUE_MASK;
+    if (type == VALUE_IS_OBJECT)
+      type = MARKED_OBJECT;
+    else if (type == VALUE_IS_ARRAY)
+      type = MARKED_ARRAY;
+    _flags = uint8_t((_flags & KEY_IS_OWNED) | COLLECTION_MASK | type);
+  }
+
+  void unmark() {
+    uint8_t type = _flags & ~(KEY_IS_OWNED | COLLECTION_MASK);
+    if (type == MARKED_OBJECT)
+      type = VALUE_IS_OBJECT;
+    else if (type == MARKED_ARRAY)
+      type = VALUE_IS_ARRAY;
+    _flags = uint8_t((_flags & KEY_IS_OWNED) | type);
+  }
+
+  // Copies the slot to dest, where next() and prev() return the same slots
+  void moveTo(VariantSlot* dest) const {
+    *dest = *this;
+    dest->setNext(const_cast<VariantSlot*>(this)->next());
+#if ARDUINOJSON_ENABLE_PREVIOUS_LINKS
+    dest->setPrev(const_cast<VariantSlot*>(this)->prev());
+#endif
+  }
+
+  template <typename TCollector>
+  void collectKey(TCollector& collector) {
+    if (_flags & KEY_IS_OWNED)
+      collector.addString(_key);
+  }
 };
 
 }  // namespace ARDUINOJSON_NAMESPACE